@@ -2,22 +2,37 @@
 #define __jetblack__maths__exp_interp_hpp
 
 #include <cmath>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 #include "maths/interp.hpp"
 
 namespace maths
 {
+	/*
+	 * The table holds the log of the interpolated value, so the values must be positive. A value
+	 * which is not is rejected before it is stored, rather than leaving a segment which gives NaN.
+	 */
 	struct ExpInterp : public Interp
     {
 		ExpInterp()
 			:	Interp()
 		{
+			table.transform = PiecewisePolynomial::Transform::Exp;
+			table.exact_knots = true;
 		}
 
 		ExpInterp(const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
 			:	Interp(xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat)
         {
+            // The powers give the points exactly, so the exp of their logs must not be used.
+            table.transform = PiecewisePolynomial::Transform::Exp;
+            table.exact_knots = true;
+            for (auto y : ya)
+                check_positive(y);
+            fit();
         }
 
 		ExpInterp(const ExpInterp& rhs)
@@ -27,14 +42,68 @@ namespace maths
 
 		virtual ~ExpInterp() {}
 
-        virtual double interpolate(double x) const
+		virtual std::shared_ptr<Interp> clone_shared() const
+		{
+			return std::make_shared<ExpInterp>(*this);
+		}
+
+		using Interp::interpolate;
+
+        virtual void add(double x, double y)
+        {
+            check_positive(y);
+            Interp::add(x, y);
+        }
+
+        virtual void set(size_t i, double y)
         {
-            return interpolate(x, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat);
+            check_positive(y);
+            Interp::set(i, y);
         }
 
-        static double interpolate(double xk, double xn, double yn)
+        virtual double last_weight(double x) const
         {
-			return ::pow(yn, xk / xn);
+            size_t n = xa.size();
+
+            if (n == 1)
+                return 1.0;
+            else if (x <= xa.front())
+                return extrapolate_near_flat || n > 2 ? 0.0 : last_weight(x, xa[0], ya[0], xa[1], ya[1]);
+            else if (x >= xa.back())
+                return extrapolate_far_flat ? 1.0 : last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else if (x > xa[n-2])
+                return last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else
+                return 0.0;
+        }
+
+        // The log of y1^a y2^b is a log(y1) + b log(y2), and a and b are quadratic in x.
+        virtual void fit_segment(size_t j, double* c) const
+        {
+            double x1 = xa[j], x2 = xa[j+1], h = x2 - x1;
+            double l1 = ::log(ya[j]), l2 = ::log(ya[j+1]);
+
+            c[0] = l1;
+            c[1] = l1 * (h - x1) / (x1 * h) + l2 * x1 / (x2 * h);
+            c[2] = l2 / (x2 * h) - l1 / (x1 * h);
+            c[3] = 0.0;
+        }
+
+        // The derivative of y1^a y2^b with respect to y1 is a y / y1.
+        virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const
+        {
+            double x1 = xa[j], x2 = xa[j+1], h = x2 - x1;
+            size_t segment = j;
+            double y = table.evaluate(x, segment);
+
+            weights[j] += scale * (x / x1) * ((x2 - x) / h) * y / ya[j];
+            weights[j+1] += scale * (x / x2) * ((x - x1) / h) * y / ya[j+1];
+        }
+
+        static void check_positive(double y)
+        {
+            if (!(y > 0.0))
+                throw std::invalid_argument("exponential interpolation needs positive values");
         }
 
         static double interpolate(double xk, double x1, double y1, double x2, double y2)
@@ -42,7 +111,19 @@ namespace maths
 			return ::pow(y1, (xk / x1) * ((x2 - xk) / (x2 - x1))) * ::pow(y2, (xk / x2) * ((xk - x1) / (x2 - x1)));
         }
 
+        static double last_weight(double xk, double x1, double y1, double x2, double y2)
+        {
+			return (xk / x2) * ((xk - x1) / (x2 - x1)) * interpolate(xk, x1, y1, x2, y2) / y2;
+        }
+
 		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
+        {
+            size_t segment = 0;
+            return interpolate(xk, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat, segment);
+        }
+
+        // The segment is a hint, which is updated to the segment containing xk.
+		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat, size_t& segment)
         {
             if (xa.size() == 0)
 				throw std::invalid_argument("vectors must not be empty. ");
@@ -69,14 +150,9 @@ namespace maths
 			}
 			else
 			{
-				for (size_t i = 0; i < n-1; ++i)
-				{
-					if (xa[i] >= xk && xk < xa[i+1])
-						return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
-				}
+				size_t i = segment = find_segment(xa, xk, segment);
+				return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
 			}
-
-			throw std::runtime_error("sack the coder");
         }
     };
 }
@@ -1,6 +1,8 @@
 #ifndef __jetblack__maths__flatfwd_interp_hpp
 #define __jetblack__maths__flatfwd_interp_hpp
 
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -14,11 +16,14 @@ namespace maths
 		FlatForwardInterp()
 			:	Interp()
 		{
+			table.transform = PiecewisePolynomial::Transform::OverX;
 		}
 
 		FlatForwardInterp(const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
 			:	Interp(xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat)
         {
+            table.transform = PiecewisePolynomial::Transform::OverX;
+            fit();
         }
 
 		FlatForwardInterp(const FlatForwardInterp& rhs)
@@ -28,14 +33,42 @@ namespace maths
 
 		virtual ~FlatForwardInterp() {}
 
-        virtual double interpolate(double x) const
+		virtual std::shared_ptr<Interp> clone_shared() const
+		{
+			return std::make_shared<FlatForwardInterp>(*this);
+		}
+
+		using Interp::interpolate;
+
+        virtual double last_weight(double x) const
+        {
+            size_t n = xa.size();
+
+            if (n == 1)
+                return 1.0;
+            else if (x <= xa.front())
+                return extrapolate_near_flat || n > 2 ? 0.0 : last_weight(x, xa[0], ya[0], xa[1], ya[1]);
+            else if (x >= xa.back())
+                return extrapolate_far_flat ? 1.0 : last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else if (x > xa[n-2])
+                return last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else
+                return 0.0;
+        }
+
+        // The rate times x is linear between the points.
+        virtual void fit_segment(size_t j, double* c) const
         {
-            return interpolate(x, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat);
+            c[0] = ya[j] * xa[j];
+            c[1] = (ya[j+1] * xa[j+1] - ya[j] * xa[j]) / (xa[j+1] - xa[j]);
+            c[2] = c[3] = 0.0;
         }
 
-        static double interpolate(double xk, double xn, double yn)
+        virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const
         {
-            return yn;
+            double b = (x - xa[j]) / (xa[j+1] - xa[j]);
+            weights[j] += scale * xa[j] * (1.0 - b) / x;
+            weights[j+1] += scale * xa[j+1] * b / x;
         }
 
         static double interpolate(double xk, double x1, double y1, double x2, double y2)
@@ -43,7 +76,19 @@ namespace maths
             return (y1 * x1 * (x2 - xk) + y2 * x2 * (xk - x1)) / (xk * (x2 - x1));
         }
 
+        static double last_weight(double xk, double x1, double y1, double x2, double y2)
+        {
+            return x2 * (xk - x1) / (xk * (x2 - x1));
+        }
+
 		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
+        {
+            size_t segment = 0;
+            return interpolate(xk, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat, segment);
+        }
+
+        // The segment is a hint, which is updated to the segment containing xk.
+		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat, size_t& segment)
         {
             if (xa.size() == 0)
                 throw std::invalid_argument("input vectors must not be empty");
@@ -70,16 +115,12 @@ namespace maths
 			}
 			else
 			{
-				for (size_t i = 0; i < n-1; ++i)
-				{
-					if (xa[i] == xk && !force_interpolation)
-						return ya[i];
-					else if (xa[i] >= xk && xk < xa[i+1])
-						return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
-				}
+				size_t i = segment = find_segment(xa, xk, segment);
+				if (xa[i] == xk && !force_interpolation)
+					return ya[i];
+				else
+					return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
 			}
-
-			throw std::runtime_error("sack the coder");
         }
     };
 }
@@ -1,6 +1,8 @@
 #ifndef __jetblack__maths__hermite_interp_hpp
 #define __jetblack__maths__hermite_interp_hpp
 
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -14,11 +16,15 @@ namespace maths
 		HermiteInterp()
 			:	Interp()
 		{
+			table.flat_left = table.flat_right = table.exact_knots = true;
 		}
 
         HermiteInterp(const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
 			:	Interp(xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat)
         {
+            // Always flat outside the points, and exact at them.
+            table.flat_left = table.flat_right = table.exact_knots = true;
+            fit();
         }
 
 		HermiteInterp(const HermiteInterp& rhs)
@@ -28,44 +34,113 @@ namespace maths
 
         virtual ~HermiteInterp() {}
 
-        virtual double interpolate(double x) const
+        virtual std::shared_ptr<Interp> clone_shared() const
         {
-            return interpolate(x, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat);
+            return std::make_shared<HermiteInterp>(*this);
+        }
+
+        using Interp::interpolate;
+
+        virtual double last_weight(double x) const
+        {
+            size_t n = xa.size();
+
+            if (n == 1 || x >= xa[n-1])
+                return 1.0;
+            else if (x < xa[0] || (n > 2 && x < xa[1]))
+                return 0.0;
+            else if (x > xa[n-2])
+                return LinearInterp::last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else if (n > 3 && x > xa[n-3])
+            {
+                // The last point only appears in the third divided difference of the last cubic segment.
+                size_t i = n - 3;
+                return (x - xa[i - 1]) * (x - xa[i]) * (x - xa[i + 1]) / ((xa[i + 2] - xa[i + 1]) * (xa[i + 2] - xa[i]) * (xa[i + 2] - xa[i - 1]));
+            }
+            else
+                return 0.0;
+        }
+
+        // The end segments are linear, and the others cubic through the two points either side.
+        virtual void fit_segment(size_t j, double* c) const
+        {
+            size_t n = xa.size();
+            double h = xa[j+1] - xa[j];
+
+            if (j == 0 || j + 2 >= n)
+            {
+                c[0] = ya[j];
+                c[1] = (ya[j+1] - ya[j]) / h;
+                c[2] = c[3] = 0.0;
+                return;
+            }
+
+            // Newton form, re-based on xa[j].
+            double h0 = xa[j] - xa[j-1];
+            double d0 = (ya[j] - ya[j-1]) / h0;
+            double d1 = ((ya[j+1] - ya[j]) / h - d0) / (xa[j+1] - xa[j-1]);
+            double d2 = (((ya[j+2] - ya[j+1]) / (xa[j+2] - xa[j+1]) - (ya[j+1] - ya[j]) / h) / (xa[j+2] - xa[j]) - d1) / (xa[j+2] - xa[j-1]);
+
+            c[0] = ya[j];
+            c[1] = d0 + d1 * h0 - d2 * h0 * h;
+            c[2] = d1 + d2 * (h0 - h);
+            c[3] = d2;
+        }
+
+        // The cubic through the four points is the sum of their Lagrange polynomials.
+        virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const
+        {
+            size_t n = xa.size();
+
+            if (j == 0 || j + 2 >= n)
+            {
+                double b = (x - xa[j]) / (xa[j+1] - xa[j]);
+                weights[j] += scale * (1.0 - b);
+                weights[j+1] += scale * b;
+                return;
+            }
+
+            for (size_t k = j - 1; k <= j + 2; ++k)
+            {
+                double l = scale;
+                for (size_t m = j - 1; m <= j + 2; ++m)
+                    if (m != k)
+                        l *= (x - xa[m]) / (xa[k] - xa[m]);
+                weights[k] += l;
+            }
         }
 
 		static double interpolate(double x, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_strat)
+        {
+            size_t segment = 0;
+            return interpolate(x, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_strat, segment);
+        }
+
+        // The segment is a hint, which is updated to the segment containing x.
+		static double interpolate(double x, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_strat, size_t& segment)
         {
             if (ya.size() != xa.size())
 				throw std::invalid_argument("the input vectors must be the same length");
             size_t n = ya.size();
 
-            size_t i = 0;
-            size_t j = n - 1;
-
             // outside bounds
-            if (x < xa[i]) return ya[i];
-            if (x > xa[j]) return ya[j];
+            if (x < xa.front()) return ya.front();
+            if (x > xa.back()) return ya.back();
+            if (n == 1) return ya.front();
 
-            //find strikes via bisection
-            while (j != i + 1)
-            {
-                int k = ((i + j) / 2);
-                if (x > xa[k])
-                    i = k;
-                else if (x < xa[k])
-                    j = k;
-                else
-                    return ya[k];
-            }
+            // The inner points are returned exactly.
+            size_t i = segment = find_segment(xa, x, segment);
+            if (i > 0 && xa[i] == x)
+                return ya[i];
 
             //linear interp if must
             if (x < xa[1])
             {
 				return LinearInterp::interpolate(x, xa[0], ya[0], xa[1], ya[1]);
             }
-            else if (x > xa[j - 1])
+            else if (x > xa[n - 2])
             {
-				return LinearInterp::interpolate(x, xa[j-1], ya[j-1], xa[j], ya[j]);
+				return LinearInterp::interpolate(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
             }
 			else
 			{
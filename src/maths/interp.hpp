@@ -1,10 +1,20 @@
 #ifndef __jetblack__maths__interp_hpp
 #define __jetblack__maths__interp_hpp
 
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
+#include "maths/piecewise_polynomial.hpp"
+
 namespace maths
 {
+	/*
+	 * The base of the interpolators. Each one compiles its points into a piecewise polynomial when
+	 * they are given or changed, by fitting the segments, and all of them are evaluated from that.
+	 */
 	class Interp
 	{
 	public:
@@ -24,6 +34,9 @@ namespace maths
 				extrapolate_near_flat(extrapolate_near_flat),
 				extrapolate_far_flat(extrapolate_far_flat)
 		{
+			table.flat_left = extrapolate_near_flat;
+			table.flat_right = extrapolate_far_flat;
+			table.exact_knots = !force_interpolation;
 		}
 
 		Interp(const Interp& rhs)
@@ -31,28 +44,188 @@ namespace maths
 				ya(rhs.ya),
 				force_interpolation(rhs.force_interpolation),
 				extrapolate_near_flat(rhs.extrapolate_near_flat),
-				extrapolate_far_flat(rhs.extrapolate_far_flat)
+				extrapolate_far_flat(rhs.extrapolate_far_flat),
+				table(rhs.table)
 		{
 		}
 
 		virtual ~Interp() {}
 
-		virtual double interpolate(double x) const = 0;
+		/*
+		 * A position held by the caller for lookups which mostly move forward, such as along a schedule.
+		 * It lives outside the interpolator so a shared interpolator has no mutable state.
+		 */
+		struct cursor
+		{
+			size_t segment {0};
+		};
+
+		virtual double interpolate(double x) const
+		{
+			size_t segment = 0;
+			return table.evaluate(x, segment);
+		}
+
+		// Interpolate starting from the segment of the last lookup with the cursor.
+		virtual double interpolate(double x, cursor& c) const
+		{
+			return table.evaluate(x, c.segment);
+		}
+
+		// Interpolate each of xs into ys.
+		virtual void interpolate_batch(std::span<const double> xs, std::span<double> ys) const
+		{
+			if (xs.size() != ys.size())
+				throw std::invalid_argument("input and output sizes differ");
+
+			if (std::ranges::is_sorted(xs))
+			{
+				interpolate_sorted(xs, ys);
+				return;
+			}
+
+			// The method is looked up once for the batch.
+			table.dispatch([&](auto t)
+			{
+				size_t segment = 0;
+				for (size_t i = 0; i < xs.size(); ++i)
+					ys[i] = table.evaluate<decltype(t)::value>(xs[i], segment);
+			});
+		}
+
+		// Interpolate xs, which should be in increasing order, into ys, walking the knots once in step
+		// with them. Values out of order are still interpolated correctly, but more slowly.
+		virtual void interpolate_sorted(std::span<const double> xs, std::span<double> ys) const
+		{
+			table.evaluate_sorted(xs, ys);
+		}
+
+		// A point after the last is appended to the table, and only the segments which depend on it
+		// are fitted. Any other point compiles the table again.
 		virtual void add(double x, double y)
 		{
+			bool appended = table.knots.size() == xa.size() && (xa.empty() || x > xa.back());
+
 			xa.push_back(x);
 			ya.push_back(y);
+
+			if (!appended)
+			{
+				fit();
+				return;
+			}
+
+			table.append(x, y);
+
+			// A segment depends on at most the two points either side of it.
+			size_t i = xa.size() - 1;
+			fit(i >= 2 ? i - 2 : 0, i + 2);
+		}
+
+		// Replace a y value in place. Used when solving for the points of a curve.
+		virtual void set(size_t i, double y)
+		{
+			ya[i] = y;
+			table.values[i] = y;
+
+			// A segment depends on at most the two points either side of it.
+			fit(i >= 2 ? i - 2 : 0, i + 2);
+		}
+
+		void set_last(double y)
+		{
+			set(ya.size() - 1, y);
+		}
+
+		// Make room for n points, so that adding up to that many allocates nothing.
+		virtual void reserve(size_t n)
+		{
+			xa.reserve(n);
+			ya.reserve(n);
+			table.reserve(n);
+		}
+
+		// The number of points there is room for before adding one allocates.
+		size_t capacity() const
+		{
+			return xa.capacity();
 		}
 
+		// The derivative of the interpolated value at x with respect to the last y value.
+		virtual double last_weight(double x) const = 0;
+
+		/*
+		 * Add scale times the derivative of the interpolated value at x with respect to each y value
+		 * to weights, which has an entry for each point. The weights are sparse for the local methods:
+		 * two points for the linear ones and four for Hermite. Every point moves a spline.
+		 */
+		void add_weights(double x, std::span<double> weights, double scale = 1.0) const
+		{
+			size_t n = xa.size();
+			if (n == 0)
+				throw std::invalid_argument("there are no points to interpolate");
+			if (weights.size() < n)
+				throw std::invalid_argument("there must be a weight for each point");
+
+			// The same cases as the table, which returns a point's value directly.
+			if (n == 1 || (table.flat_left && x < xa.front()))
+				weights[0] += scale;
+			else if ((table.flat_right && x > xa.back()) || (table.exact_knots && x == xa.back()))
+				weights[n-1] += scale;
+			else
+			{
+				size_t j = table.find(x, 0);
+				if (table.exact_knots && x == xa[j])
+					weights[j] += scale;
+				else
+					add_segment_weights(j, x, scale, weights);
+			}
+		}
+
+		virtual std::shared_ptr<Interp> clone_shared() const = 0;
+
 		const std::vector<double>& get_xa() const { return xa; }
 		const std::vector<double>& get_ya() const { return ya; }
+		const PiecewisePolynomial& get_table() const { return table; }
+
+		static size_t find_segment(const std::vector<double>& xa, double x, size_t hint)
+		{
+			return PiecewisePolynomial::find_segment(xa, x, hint);
+		}
+
+		static size_t advance_segment(const std::vector<double>& xa, double x, size_t segment)
+		{
+			return PiecewisePolynomial::advance_segment(xa, x, segment);
+		}
 
 	protected:
+		// Fill in the coefficients of segment j, between xa[j] and xa[j+1].
+		virtual void fit_segment(size_t j, double* c) const = 0;
+
+		// Add the weights of the points for x evaluated on segment j, which may be beyond the points.
+		virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const = 0;
+
+		// Compile all the points. The derived constructors call this once their own state is set.
+		void fit()
+		{
+			table.reset(xa, ya);
+			fit(0, table.segment_count());
+		}
+
+		// Refit the segments from first up to, but not including, last.
+		void fit(size_t first, size_t last)
+		{
+			last = std::min(last, table.segment_count());
+			for (size_t j = first; j < last; ++j)
+				fit_segment(j, table.segment(j));
+		}
+
 		std::vector<double> xa;
 		std::vector<double> ya;
 		bool force_interpolation; // require interpolation rather than accepting an exact match
         bool extrapolate_near_flat;
         bool extrapolate_far_flat;
+		PiecewisePolynomial table;
 	};
 }
 
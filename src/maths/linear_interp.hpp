@@ -1,6 +1,8 @@
 #ifndef __jetblack__maths__linear_interp_hpp
 #define __jetblack__maths__linear_interp_hpp
 
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -18,6 +20,7 @@ namespace maths
 		LinearInterp(const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
 			:	Interp(xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat)
         {
+            fit();
         }
 
 		LinearInterp(const LinearInterp& rhs)
@@ -27,9 +30,41 @@ namespace maths
 
 		virtual ~LinearInterp() {}
 
-        virtual double interpolate(double x) const
+		virtual std::shared_ptr<Interp> clone_shared() const
+		{
+			return std::make_shared<LinearInterp>(*this);
+		}
+
+		using Interp::interpolate;
+
+        virtual double last_weight(double x) const
         {
-            return interpolate(x, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat);
+            size_t n = xa.size();
+
+            if (n == 1)
+                return 1.0;
+            else if (x <= xa.front())
+                return extrapolate_near_flat || n > 2 ? 0.0 : last_weight(x, xa[0], ya[0], xa[1], ya[1]);
+            else if (x >= xa.back())
+                return extrapolate_far_flat ? 1.0 : last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else if (x > xa[n-2])
+                return last_weight(x, xa[n-2], ya[n-2], xa[n-1], ya[n-1]);
+            else
+                return 0.0;
+        }
+
+        virtual void fit_segment(size_t j, double* c) const
+        {
+            c[0] = ya[j];
+            c[1] = (ya[j+1] - ya[j]) / (xa[j+1] - xa[j]);
+            c[2] = c[3] = 0.0;
+        }
+
+        virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const
+        {
+            double b = (x - xa[j]) / (xa[j+1] - xa[j]);
+            weights[j] += scale * (1.0 - b);
+            weights[j+1] += scale * b;
         }
 
 		static double interpolate(double xk, double x1, double y1, double x2, double y2)
@@ -37,7 +72,19 @@ namespace maths
 			return y1 + (xk - x1) / (x2 - x1) * (y2 - y1);
 		}
 
+		static double last_weight(double xk, double x1, double y1, double x2, double y2)
+		{
+			return (xk - x1) / (x2 - x1);
+		}
+
 		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat)
+        {
+            size_t segment = 0;
+            return interpolate(xk, xa, ya, force_interpolation, extrapolate_near_flat, extrapolate_far_flat, segment);
+        }
+
+        // The segment is a hint, which is updated to the segment containing xk.
+		static double interpolate(double xk, const std::vector<double>& xa, const std::vector<double>& ya, bool force_interpolation, bool extrapolate_near_flat, bool extrapolate_far_flat, size_t& segment)
         {
             if (xa.size() == 0)
 				throw std::invalid_argument("input vectors must not be empty");
@@ -64,16 +111,12 @@ namespace maths
 			}
 			else
 			{
-				for (size_t i = 0; i < n-1; ++i)
-				{
-					if (xa[i] == xk && !force_interpolation)
-						return ya[i];
-					else if (xa[i] <= xk && xk < xa[i+1])
-						return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
-				}
+				size_t i = segment = find_segment(xa, xk, segment);
+				if (xa[i] == xk && !force_interpolation)
+					return ya[i];
+				else
+					return interpolate(xk, xa[i], ya[i], xa[i+1], ya[i+1]);
 			}
-
-			throw std::runtime_error("sack the coder");
         }
     };
 }
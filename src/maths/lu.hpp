@@ -0,0 +1,94 @@
+#ifndef __jetblack__maths__lu_hpp
+#define __jetblack__maths__lu_hpp
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace maths
+{
+    namespace lu
+    {
+        /*
+         * In place LU decomposition with partial pivoting of the n x n row-major matrix a.
+         */
+        inline void decompose(std::vector<double>& a, size_t n, std::vector<size_t>& pivots)
+        {
+            if (a.size() != n * n)
+                throw std::invalid_argument("the matrix must be square");
+
+            pivots.resize(n);
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                size_t p = k;
+                for (size_t i = k + 1; i < n; ++i)
+                    if (fabs(a[i * n + k]) > fabs(a[p * n + k]))
+                        p = i;
+
+                if (a[p * n + k] == 0.0)
+                    throw std::runtime_error("singular matrix");
+
+                pivots[k] = p;
+                if (p != k)
+                    for (size_t j = 0; j < n; ++j)
+                        std::swap(a[k * n + j], a[p * n + j]);
+
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    double l = a[i * n + k] /= a[k * n + k];
+                    if (l == 0.0)
+                        continue; // Bootstrap jacobians are close to triangular, so skip the empty rows.
+
+                    for (size_t j = k + 1; j < n; ++j)
+                        a[i * n + j] -= l * a[k * n + j];
+                }
+            }
+        }
+
+        /*
+         * Solve a x = b in place using the output of decompose.
+         */
+        inline void solve(const std::vector<double>& a, size_t n, const std::vector<size_t>& pivots, std::vector<double>& b)
+        {
+            for (size_t k = 0; k < n; ++k)
+                if (pivots[k] != k)
+                    std::swap(b[k], b[pivots[k]]);
+
+            for (size_t i = 1; i < n; ++i)
+                for (size_t j = 0; j < i; ++j)
+                    b[i] -= a[i * n + j] * b[j];
+
+            for (size_t i = n; i-- > 0;)
+            {
+                for (size_t j = i + 1; j < n; ++j)
+                    b[i] -= a[i * n + j] * b[j];
+                b[i] /= a[i * n + i];
+            }
+        }
+
+        /*
+         * Solve transpose(a) x = b in place using the output of decompose.
+         */
+        inline void solve_transpose(const std::vector<double>& a, size_t n, const std::vector<size_t>& pivots, std::vector<double>& b)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t j = 0; j < i; ++j)
+                    b[i] -= a[j * n + i] * b[j];
+                b[i] /= a[i * n + i];
+            }
+
+            for (size_t i = n; i-- > 0;)
+                for (size_t j = i + 1; j < n; ++j)
+                    b[i] -= a[j * n + i] * b[j];
+
+            for (size_t k = n; k-- > 0;)
+                if (pivots[k] != k)
+                    std::swap(b[k], b[pivots[k]]);
+        }
+    }
+}
+
+#endif // __jetblack__maths__lu_hpp
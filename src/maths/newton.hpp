@@ -0,0 +1,70 @@
+#ifndef __jetblack__maths__newton_hpp
+#define __jetblack__maths__newton_hpp
+
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace maths
+{
+    namespace newton
+    {
+        /*
+         * Newton-Raphson, where the objective returns the value and the derivative as a pair.
+         * The iteration is abandoned with a range_error if it leaves the bracket [xMin, xMax],
+         * the derivative vanishes, or it fails to converge, so the caller can fall back to a
+         * bracketing solver.
+         */
+		template <typename F>
+		requires std::invocable<F&, double>
+        double solve(
+            F of,
+            double x0,
+            double xMin,
+            double xMax,
+            unsigned int maxIterations = 100,
+            double errorThreshold = std::numeric_limits<double>::epsilon())
+        {
+            const double machinePrecision = std::numeric_limits<double>::epsilon();
+
+            double x = x0;
+
+            for (unsigned int iteration = 0; iteration < maxIterations; ++iteration)
+            {
+                auto [f, df] = of(x);
+
+                if (f == 0.0)
+                {
+                    return x;
+                }
+
+                if (df == 0.0 || !std::isfinite(f) || !std::isfinite(df))
+                {
+                    break;
+                }
+
+                double dx = f / df;
+                x -= dx;
+
+                if (x < xMin || x > xMax)
+                {
+                    break;
+                }
+
+                // Convergence check.
+                double tol = 2.0 * machinePrecision * fabs(x) + errorThreshold;
+                if (fabs(dx) <= tol)
+                {
+                    return x;
+                }
+            }
+
+            throw std::range_error("Failed to find root");
+        }
+    }
+}
+
+#endif // __jetblack__maths__newton_hpp
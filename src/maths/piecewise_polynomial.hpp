@@ -0,0 +1,302 @@
+#ifndef __jetblack__maths__piecewise_polynomial_hpp
+#define __jetblack__maths__piecewise_polynomial_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "maths/simd.hpp"
+
+namespace maths
+{
+	/*
+	 * The compiled form of an interpolator: a cubic for each segment between the knots, with
+	 * coefficients in powers of the distance from the knot at the start of the segment, so
+	 * p(x) = c0 + c1 d + c2 d^2 + c3 d^3 where d = x - knots[j].
+	 *
+	 * Methods which are not polynomial in x are polynomial after a transform: the flat forward
+	 * rate times x is linear, and the log of the exponential interpolation is quadratic. The end
+	 * segments are extended beyond the knots, or the end values are held flat.
+	 *
+	 * Every method evaluates through the same kernel, a segment lookup and a Horner step. The
+	 * transform is the only choice left, and dispatch makes it once for a loop of evaluations.
+	 *
+	 * Tables with many knots, such as daily discount curves, also get an index of equal width
+	 * buckets over the knots, holding the segment at the start of each bucket. A lookup is then a
+	 * multiply, a load, and a step or two, rather than a binary search. Knots appended after the
+	 * index was built are found by the search, and the index is rebuilt when the knots double, so
+	 * appending knots one at a time costs a constant amount for each on average.
+	 */
+	struct PiecewisePolynomial
+	{
+		static constexpr size_t order = 4;
+		// The fewest knots for which the bucket index is built.
+		static constexpr size_t index_min_knots = 128;
+		// The most segments starting in one bucket. Knots more clustered than this are left to the binary search.
+		static constexpr size_t index_max_steps = 4;
+
+		enum class Transform
+		{
+			Identity,	// y = p(x)
+			OverX,		// y = p(x) / x
+			Exp			// y = exp(p(x))
+		};
+
+		std::vector<double> knots;
+		std::vector<double> values;
+		std::vector<double> coefficients; // order for each segment
+		Transform transform {Transform::Identity};
+		bool flat_left {false};
+		bool flat_right {false};
+		bool exact_knots {true}; // return the values at the knots rather than evaluating the polynomial
+
+		size_t segment_count() const { return knots.size() > 1 ? knots.size() - 1 : 0; }
+		bool indexed() const { return !index.empty(); }
+
+		double* segment(size_t j) { return coefficients.data() + order * j; }
+		const double* segment(size_t j) const { return coefficients.data() + order * j; }
+
+		// Set the knots and values, leaving the coefficients to be filled in.
+		void reset(const std::vector<double>& xa, const std::vector<double>& ya)
+		{
+			if (xa.size() != ya.size())
+				throw std::invalid_argument("input vectors must be the same length");
+
+			knots = xa;
+			values = ya;
+			coefficients.assign(order * segment_count(), 0.0);
+			build_index();
+		}
+
+		// Add a knot after the last, leaving the coefficients of its segment to be filled in.
+		void append(double x, double y)
+		{
+			if (!knots.empty() && !(x > knots.back()))
+				throw std::invalid_argument("the knot must be after the last");
+
+			knots.push_back(x);
+			values.push_back(y);
+			coefficients.resize(order * segment_count(), 0.0);
+
+			if (knots.size() >= index_min_knots && knots.size() >= 2 * index_knots)
+				build_index();
+		}
+
+		void reserve(size_t n)
+		{
+			knots.reserve(n);
+			values.reserve(n);
+			coefficients.reserve(order * n);
+			if (n >= index_min_knots)
+				index.reserve(n);
+		}
+
+		// The segment containing x, as find_segment, using the bucket index when there is one.
+		size_t find(double x, size_t hint) const
+		{
+			size_t n = knots.size();
+			if (index.empty() || (hint + 1 < n && knots[hint] <= x && x < knots[hint+1]))
+				return find_segment(knots, x, hint);
+
+			if (x < knots.front())
+				return 0;
+			if (!(x < index_end))
+				return find_segment(knots, x, hint);
+
+			size_t k = std::min(static_cast<size_t>((x - knots.front()) * index_scale), index.size() - 1);
+			size_t j = index[k];
+
+			// The bucket edges are rounded, so x may be just before the start of its bucket.
+			while (j > 0 && x < knots[j])
+				--j;
+			while (j + 2 < n && knots[j+1] <= x)
+				++j;
+			return j;
+		}
+
+		/*
+		 * Call f with the transform as a std::integral_constant, so the evaluations f makes with
+		 * evaluate<T> have no branch on the transform and can be inlined into its loop.
+		 */
+		template <typename F>
+		decltype(auto) dispatch(F&& f) const
+		{
+			switch (transform)
+			{
+			case Transform::OverX:
+				return f(std::integral_constant<Transform, Transform::OverX>{});
+			case Transform::Exp:
+				return f(std::integral_constant<Transform, Transform::Exp>{});
+			default:
+				return f(std::integral_constant<Transform, Transform::Identity>{});
+			}
+		}
+
+		// The segment is a hint, which is updated to the segment containing x.
+		double evaluate(double x, size_t& segment) const
+		{
+			return dispatch([&](auto t) { return evaluate<decltype(t)::value>(x, segment); });
+		}
+
+		// The evaluation for a transform known at compile time, which must be the table's.
+		template <Transform T>
+		double evaluate(double x, size_t& segment) const
+		{
+			if (knots.size() < 2)
+				return evaluate_constant();
+
+			size_t j = segment = find(x, segment);
+			return evaluate_segment<T>(x, j);
+		}
+
+		// Evaluate each of xs into ys, walking the knots once when xs are in increasing order.
+		void evaluate_sorted(std::span<const double> xs, std::span<double> ys) const
+		{
+			if (xs.size() != ys.size())
+				throw std::invalid_argument("input and output sizes differ");
+
+			if (knots.size() < 2)
+			{
+				std::ranges::fill(ys, evaluate_constant());
+				return;
+			}
+
+			// The transform is chosen once for the batch, so the loops have no branches.
+			dispatch([&](auto t) { evaluate_blocks<decltype(t)::value>(xs, ys); });
+		}
+
+		// The index i with xa[i] <= x < xa[i+1], for xa.front() <= x < xa.back(). The hint and the
+		// segment after it are tried first, so increasing lookups take constant time, and otherwise
+		// the segment is found by binary search.
+		static size_t find_segment(const std::vector<double>& xa, double x, size_t hint)
+		{
+			size_t n = xa.size();
+			if (hint + 1 < n && xa[hint] <= x)
+			{
+				if (x < xa[hint+1])
+					return hint;
+				if (hint + 2 < n && x < xa[hint+2])
+					return hint + 1;
+			}
+
+			// Extrapolation uses the end segments.
+			if (x < xa.front())
+				return 0;
+			if (x >= xa.back())
+				return n - 2;
+
+			// Clamped so that a value outside the range, or NaN, still gives a valid segment.
+			size_t i = static_cast<size_t>(std::upper_bound(xa.begin(), xa.end(), x) - xa.begin());
+			return i == 0 ? 0 : std::min(i - 1, n - 2);
+		}
+
+		// Move the segment forward while x is beyond it, so that for increasing xs the knots are
+		// walked once in all.
+		static size_t advance_segment(const std::vector<double>& xa, double x, size_t segment)
+		{
+			while (segment + 2 < xa.size() && xa[segment+1] <= x)
+				++segment;
+			return segment;
+		}
+
+	private:
+		// The number of xs whose segments are found before the kernel runs over them.
+		static constexpr size_t batch_block = 256;
+
+		std::vector<std::uint32_t> index; // the segment containing the start of each bucket
+		double index_scale {0}; // buckets per unit of x
+		double index_end {0}; // the last knot when the index was built
+		size_t index_knots {0}; // the number of knots when the index was built
+
+		// One bucket for each segment, which is dropped when the knots are too uneven for it to help.
+		void build_index()
+		{
+			index.clear();
+
+			size_t n = knots.size();
+			index_knots = n;
+			if (n < index_min_knots || !(knots.back() > knots.front()))
+				return;
+
+			size_t buckets = n - 1;
+			index_scale = buckets / (knots.back() - knots.front());
+			index_end = knots.back();
+			index.resize(buckets);
+
+			size_t j = 0;
+			for (size_t k = 0; k < buckets; ++k)
+			{
+				double start = knots.front() + k / index_scale;
+				size_t first = j;
+				while (j + 2 < n && knots[j+1] <= start)
+					++j;
+
+				if (j - first > index_max_steps)
+				{
+					index.clear();
+					return;
+				}
+
+				index[k] = static_cast<std::uint32_t>(j);
+			}
+
+			if (n - 2 - j > index_max_steps)
+				index.clear();
+		}
+
+		double evaluate_constant() const
+		{
+			if (knots.empty())
+				throw std::invalid_argument("there are no points to interpolate");
+			return values.front();
+		}
+
+		// Straight line code with selects rather than branches, so the batch loop can be vectorised.
+		template <Transform T>
+		double evaluate_segment(double x, size_t j) const
+		{
+			const double* c = segment(j);
+			double d = x - knots[j];
+			double p = ((c[3] * d + c[2]) * d + c[1]) * d + c[0];
+
+			double y;
+			if constexpr (T == Transform::OverX)
+				y = p / x;
+			else if constexpr (T == Transform::Exp)
+				y = simd::exp(p);
+			else
+				y = p;
+
+			y = exact_knots && d == 0.0 ? values[j] : y;
+			y = exact_knots && x == knots.back() ? values.back() : y;
+			y = flat_left && x < knots.front() ? values.front() : y;
+			y = flat_right && x > knots.back() ? values.back() : y;
+			return y;
+		}
+
+		// Find the segments of a block of xs first, then evaluate the block.
+		template <Transform T>
+		void evaluate_blocks(std::span<const double> xs, std::span<double> ys) const
+		{
+			size_t segments[batch_block];
+			size_t segment = 0;
+			for (size_t start = 0; start < xs.size(); start += batch_block)
+			{
+				size_t m = std::min(batch_block, xs.size() - start);
+				for (size_t i = 0; i < m; ++i)
+				{
+					double x = xs[start + i];
+					segments[i] = segment = find(x, index.empty() ? advance_segment(knots, x, segment) : segment);
+				}
+
+				for (size_t i = 0; i < m; ++i)
+					ys[start + i] = evaluate_segment<T>(xs[start + i], segments[i]);
+			}
+		}
+	};
+}
+
+#endif // __jetblack__maths__piecewise_polynomial_hpp
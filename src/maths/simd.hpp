@@ -0,0 +1,81 @@
+#ifndef __jetblack__maths__simd_hpp
+#define __jetblack__maths__simd_hpp
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+namespace maths
+{
+    /*
+     * Kernels written for the compiler to vectorise: straight line code over contiguous arrays, with
+     * selects rather than branches, and no calls into the maths library. They rely on the compiler's
+     * auto-vectoriser rather than intrinsics, so the same code serves AVX2, AVX-512 and NEON when the
+     * target allows it, and is correct scalar code when it does not. Clang turns the selects into
+     * blends by default, while GCC needs -fno-trapping-math, and -O3 for the spans which may overlap.
+     * The Makefiles set these and -march=native in OPT. Without vectorising, the exponential costs
+     * about the same as std::exp.
+     */
+    namespace simd
+    {
+        // The largest difference between exp and std::exp for arguments in [exp_min, exp_max].
+        constexpr double exp_max_ulp = 2.0;
+        constexpr double exp_min = -708.0;
+        constexpr double exp_max = 709.0;
+
+        /*
+         * The exponential by range reduction, exp(x) = 2^n exp(r) with |r| <= ln(2)/2, a Taylor
+         * polynomial for exp(r), and 2^n made directly from its bits. Results beyond exp_max are
+         * infinite and below exp_min are zero, rather than going through the subnormals.
+         */
+        inline double exp(double x)
+        {
+            constexpr double log2e = 1.44269504088896338700e+00;
+            constexpr double ln2_hi = 6.93147180369123816490e-01; // the high bits, so n * ln2_hi is exact
+            constexpr double ln2_lo = 1.90821492927058770002e-10;
+            constexpr double shifter = 0x1.8p52; // adding this rounds to an integer held in the low bits
+
+            double xc = x < exp_min ? exp_min : x;
+            xc = xc > exp_max ? exp_max : xc;
+
+            double k = xc * log2e + shifter;
+            double n = k - shifter;
+            double r = (xc - n * ln2_hi) - n * ln2_lo;
+
+            double q = 1.0 / 6227020800.0;
+            q = q * r + 1.0 / 479001600.0;
+            q = q * r + 1.0 / 39916800.0;
+            q = q * r + 1.0 / 3628800.0;
+            q = q * r + 1.0 / 362880.0;
+            q = q * r + 1.0 / 40320.0;
+            q = q * r + 1.0 / 5040.0;
+            q = q * r + 1.0 / 720.0;
+            q = q * r + 1.0 / 120.0;
+            q = q * r + 1.0 / 24.0;
+            q = q * r + 1.0 / 6.0;
+            q = q * r + 0.5;
+
+            double scale = std::bit_cast<double>((std::bit_cast<std::uint64_t>(k) + 1023) << 52);
+            double y = (1.0 + (r + r * r * q)) * scale;
+
+            y = x > exp_max ? std::numeric_limits<double>::infinity() : y;
+            y = x < exp_min ? 0.0 : y;
+            return x != x ? x : y;
+        }
+
+        // ys = exp(xs), which may be the same span.
+        inline void exp(std::span<const double> xs, std::span<double> ys)
+        {
+            if (xs.size() != ys.size())
+                throw std::invalid_argument("input and output sizes differ");
+
+            for (size_t i = 0; i < xs.size(); ++i)
+                ys[i] = exp(xs[i]);
+        }
+    }
+}
+
+#endif // __jetblack__maths__simd_hpp
@@ -0,0 +1,197 @@
+#ifndef __jetblack__maths__spline_hpp
+#define __jetblack__maths__spline_hpp
+
+#include <span>
+#include <stdexcept>
+
+namespace maths
+{
+    /*
+     * The second derivatives of the cubic spline through (xa, ya), with first derivatives yp1 and
+     * ypn at the ends, or natural ends where these are above 0.99e30.
+     *
+     * The tridiagonal system is solved into storage given by the caller, at least as long as xa, so
+     * nothing is allocated. Its decomposition depends only on xa, and the forward sweep at point i
+     * only on the points up to i + 1, so when a point is added or a y value changed both restart
+     * there, and only the back substitution runs over every point.
+     */
+    namespace spline
+    {
+        inline bool is_natural(double yp)
+        {
+            return yp > 0.99e30;
+        }
+
+        /*
+         * Decompose the system from point first, keeping the decomposition of the points before it.
+         */
+        inline void decompose(std::span<const double> xa, double yp1, std::span<double> decomposition, size_t first = 0)
+        {
+            size_t n = xa.size();
+            if (n < 2)
+                throw std::invalid_argument("the curve must have at least two points");
+            if (decomposition.size() < n)
+                throw std::invalid_argument("the workspace is smaller than the curve");
+
+            if (first == 0)
+            {
+                decomposition[0] = is_natural(yp1) ? 0.0 : -0.5;
+                first = 1;
+            }
+
+            for (size_t i = first; i + 1 < n; ++i)
+            {
+                double sig = (xa[i] - xa[i-1]) / (xa[i+1] - xa[i-1]);
+                decomposition[i] = (sig - 1.0) / (sig * decomposition[i-1] + 2.0);
+            }
+        }
+
+        /*
+         * Solve for the second derivatives y2 when the y values from point changed onwards are new,
+         * reusing the forward sweep u of an earlier solve before it.
+         */
+        inline void solve(
+            std::span<const double> xa,
+            std::span<const double> ya,
+            double yp1,
+            double ypn,
+            std::span<const double> decomposition,
+            std::span<double> u,
+            std::span<double> y2,
+            size_t changed = 0)
+        {
+            size_t n = xa.size();
+            if (n < 2)
+                throw std::invalid_argument("the curve must have at least two points");
+            if (ya.size() != n)
+                throw std::invalid_argument("input arrays must be the same length");
+            if (decomposition.size() < n || u.size() < n || y2.size() < n)
+                throw std::invalid_argument("the workspace is smaller than the curve");
+
+            size_t first = changed > 0 ? changed - 1 : 0;
+            if (first == 0)
+            {
+                u[0] = is_natural(yp1) ? 0.0 : (3.0 / (xa[1] - xa[0])) * ((ya[1] - ya[0]) / (xa[1] - xa[0]) - yp1);
+                first = 1;
+            }
+
+            for (size_t i = first; i + 1 < n; ++i)
+            {
+                double sig = (xa[i] - xa[i-1]) / (xa[i+1] - xa[i-1]);
+                double p = sig * decomposition[i-1] + 2.0;
+                double d = (ya[i+1] - ya[i]) / (xa[i+1] - xa[i]) - (ya[i] - ya[i-1]) / (xa[i] - xa[i-1]);
+                u[i] = (6.0 * d / (xa[i+1] - xa[i-1]) - sig * u[i-1]) / p;
+            }
+
+            double qn = 0.0, un = 0.0;
+            if (!is_natural(ypn))
+            {
+                qn = 0.5;
+                un = (3.0 / (xa[n-1] - xa[n-2])) * (ypn - (ya[n-1] - ya[n-2]) / (xa[n-1] - xa[n-2]));
+            }
+
+            y2[n-1] = (un - qn * u[n-2]) / (qn * decomposition[n-2] + 1.0);
+            for (size_t k = n - 1; k-- > 0;)
+                y2[k] = decomposition[k] * y2[k+1] + u[k];
+        }
+
+        /*
+         * The derivatives of the second derivatives with respect to the last y value. They are
+         * affine in y, and only the last forward step and the end condition depend on the last point,
+         * so these depend only on xa.
+         */
+        inline void last_weights(
+            std::span<const double> xa,
+            double yp1,
+            double ypn,
+            std::span<const double> decomposition,
+            std::span<double> y2last)
+        {
+            size_t n = xa.size();
+            if (n < 2)
+                throw std::invalid_argument("the curve must have at least two points");
+            if (decomposition.size() < n || y2last.size() < n)
+                throw std::invalid_argument("the workspace is smaller than the curve");
+
+            double h = xa[n-1] - xa[n-2];
+            double du = n == 2
+                ? (is_natural(yp1) ? 0.0 : 3.0 / (h * h))
+                : 6.0 / (h * (xa[n-1] - xa[n-3])) / ((xa[n-2] - xa[n-3]) / (xa[n-1] - xa[n-3]) * decomposition[n-3] + 2.0);
+            double qn = is_natural(ypn) ? 0.0 : 0.5;
+            double dun = is_natural(ypn) ? 0.0 : -3.0 / (h * h);
+
+            y2last[n-1] = (dun - qn * du) / (qn * decomposition[n-2] + 1.0);
+            y2last[n-2] = decomposition[n-2] * y2last[n-1] + du;
+            for (size_t k = n - 2; k-- > 0;)
+                y2last[k] = decomposition[k] * y2last[k+1];
+        }
+
+        /*
+         * Add the derivatives of w_lo y2[lo] + w_hi y2[lo+1] with respect to each y value to
+         * weights. This is the solve run backwards, carrying the adjoints of the forward sweep in
+         * ubar, at least as long as xa, so the cost is the same as a solve for all the points at once.
+         */
+        inline void add_weights(
+            std::span<const double> xa,
+            double yp1,
+            double ypn,
+            std::span<const double> decomposition,
+            size_t lo,
+            double w_lo,
+            double w_hi,
+            std::span<double> ubar,
+            std::span<double> weights)
+        {
+            size_t n = xa.size();
+            if (n < 2)
+                throw std::invalid_argument("the curve must have at least two points");
+            if (lo + 1 >= n)
+                throw std::out_of_range("the segment is beyond the curve");
+            if (decomposition.size() < n || ubar.size() < n || weights.size() < n)
+                throw std::invalid_argument("the workspace is smaller than the curve");
+
+            // The back substitution, from the first point.
+            double carry = 0.0;
+            for (size_t k = 0; k + 1 < n; ++k)
+            {
+                ubar[k] = carry + (k == lo ? w_lo : 0.0) + (k == lo + 1 ? w_hi : 0.0);
+                carry = decomposition[k] * ubar[k];
+            }
+            double y2nbar = carry + (lo + 2 == n ? w_hi : 0.0);
+
+            // The end condition.
+            double qn = is_natural(ypn) ? 0.0 : 0.5;
+            double unbar = y2nbar / (qn * decomposition[n-2] + 1.0);
+            ubar[n-2] -= qn * unbar;
+            if (!is_natural(ypn))
+            {
+                double h = xa[n-1] - xa[n-2];
+                weights[n-1] -= unbar * 3.0 / (h * h);
+                weights[n-2] += unbar * 3.0 / (h * h);
+            }
+
+            // The forward sweep, from the last point.
+            for (size_t i = n - 2; i >= 1; --i)
+            {
+                double sig = (xa[i] - xa[i-1]) / (xa[i+1] - xa[i-1]);
+                double p = sig * decomposition[i-1] + 2.0;
+                double dbar = ubar[i] * 6.0 / ((xa[i+1] - xa[i-1]) * p);
+                ubar[i-1] -= sig / p * ubar[i];
+
+                double h0 = xa[i] - xa[i-1], h1 = xa[i+1] - xa[i];
+                weights[i+1] += dbar / h1;
+                weights[i] -= dbar / h1 + dbar / h0;
+                weights[i-1] += dbar / h0;
+            }
+
+            if (!is_natural(yp1))
+            {
+                double h = xa[1] - xa[0];
+                weights[1] += ubar[0] * 3.0 / (h * h);
+                weights[0] -= ubar[0] * 3.0 / (h * h);
+            }
+        }
+    }
+}
+
+#endif // __jetblack__maths__spline_hpp
@@ -1,10 +1,14 @@
 #ifndef __jetblack__maths__spline_interp_hpp
 #define __jetblack__maths__spline_interp_hpp
 
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 #include "maths/interp.hpp"
-#include "NR/NR.hpp"
+#include "maths/spline.hpp"
 
 namespace maths
 {
@@ -24,43 +28,157 @@ namespace maths
 				ypn(ypn)
 		{
 			initialise();
+			fit();
 		}
 
 		SplineIterp(const SplineIterp& rhs)
 			:	Interp(rhs),
 				y2axis(rhs.y2axis),
 				yp1(rhs.yp1),
-				ypn(rhs.ypn)
+				ypn(rhs.ypn),
+				decomposition(rhs.decomposition),
+				u(rhs.u),
+				y2last(rhs.y2last)
 		{
 		}
 
 		virtual ~SplineIterp() {}
 
-		virtual double interpolate(double x) const
+		virtual std::shared_ptr<Interp> clone_shared() const
 		{
+			return std::make_shared<SplineIterp>(*this);
+		}
+
+		virtual double last_weight(double x) const
+		{
+			size_t n = xa.size();
+
 			if (x < xa.front() && extrapolate_near_flat)
-				return ya.front();
+				return 0.0;
 			else if (x > xa.back() && extrapolate_far_flat)
-				return ya.back();
-			else
-			{
-				if (!force_interpolation)
-					for (size_t i = 0; i < xa.size(); ++i)
-						if (xa[i] == x)
-							return ya[i];
+				return 1.0;
 
-				return NR::splint(xa, ya, y2axis, x);
+			size_t klo = 0, khi = n - 1;
+			while (khi - klo > 1)
+			{
+				size_t k = (khi + klo) >> 1;
+				if (xa[k] > x)
+					khi = k;
+				else
+					klo = k;
 			}
+
+			double h = xa[khi] - xa[klo];
+			double a = (xa[khi] - x) / h;
+			double b = (x - xa[klo]) / h;
+			return (khi == n - 1 ? b : 0.0) + ((a * a * a - a) * y2last[klo] + (b * b * b - b) * y2last[khi]) * (h * h) / 6.0;
 		}
 
+		// Only the new point's steps of the decomposition and forward sweep are taken, and the back
+		// substitution. Nothing is allocated while there is room reserved for the point.
 		virtual void add(double x, double y)
 		{
-			dynamic_cast<Interp*>(this)->add(x, y);
-			initialise();
+			xa.push_back(x);
+			ya.push_back(y);
+
+			size_t n = xa.size();
+			if (n <= 2 || decomposition.size() + 1 != n || table.knots.size() + 1 != n || !(x > xa[n-2]))
+			{
+				initialise();
+				fit();
+				return;
+			}
+
+			resize(n);
+			spline::decompose(xa, yp1, decomposition, n - 2);
+			spline::solve(xa, ya, yp1, ypn, decomposition, u, y2axis, n - 1);
+			spline::last_weights(xa, yp1, ypn, decomposition, y2last);
+
+			// Every segment depends on every point, but the knots are not copied again.
+			table.append(x, y);
+			fit(0, table.segment_count());
+		}
+
+		// The decomposition does not depend on the y values, so only the forward sweep from
+		// the changed point and the back substitution are repeated. For the last point this
+		// is a single step of the sweep. Every segment depends on every point, so all are refitted.
+		virtual void set(size_t i, double y)
+		{
+			ya[i] = y;
+			table.values[i] = y;
+
+			spline::solve(xa, ya, yp1, ypn, decomposition, u, y2axis, i);
+			fit(0, table.segment_count());
+		}
+
+		virtual void reserve(size_t n)
+		{
+			Interp::reserve(n);
+			y2axis.reserve(n);
+			decomposition.reserve(n);
+			u.reserve(n);
+			y2last.reserve(n);
+		}
+
+	protected:
+		// The cubic between the points, from the second derivatives at either end.
+		virtual void fit_segment(size_t j, double* c) const
+		{
+			double h = xa[j+1] - xa[j];
+			if (h == 0.0)
+				throw std::invalid_argument("the points must be distinct");
+
+			c[0] = ya[j];
+			c[1] = (ya[j+1] - ya[j]) / h - h * (2.0 * y2axis[j] + y2axis[j+1]) / 6.0;
+			c[2] = y2axis[j] / 2.0;
+			c[3] = (y2axis[j+1] - y2axis[j]) / (6.0 * h);
+		}
+
+		// The value is a y[j] + b y[j+1] plus terms in the second derivatives at either end, and
+		// each of those depends on every y value through the tridiagonal system.
+		virtual void add_segment_weights(size_t j, double x, double scale, std::span<double> weights) const
+		{
+			double h = xa[j+1] - xa[j];
+			double a = (xa[j+1] - x) / h;
+			double b = (x - xa[j]) / h;
+			weights[j] += scale * a;
+			weights[j+1] += scale * b;
+
+			thread_local std::vector<double> ubar;
+			ubar.resize(xa.size());
+			spline::add_weights(
+				xa, yp1, ypn, decomposition, j,
+				scale * (a * a * a - a) * h * h / 6.0,
+				scale * (b * b * b - b) * h * h / 6.0,
+				ubar, weights);
 		}
 
 	private:
-		void initialise() { y2axis = NR::spline(xa, ya, yp1, ypn); }
+		std::vector<double> decomposition;
+		std::vector<double> u;
+		std::vector<double> y2last; // the derivatives of y2axis with respect to the last y value
+
+		void initialise()
+		{
+			size_t n = xa.size();
+			if (n < 2)
+				throw std::invalid_argument("the curve must have at least two points");
+			else if (n != ya.size())
+				throw std::invalid_argument("input arrays must be the same length");
+
+			resize(n);
+			spline::decompose(xa, yp1, decomposition);
+			spline::solve(xa, ya, yp1, ypn, decomposition, u, y2axis);
+			spline::last_weights(xa, yp1, ypn, decomposition, y2last);
+		}
+
+		void resize(size_t n)
+		{
+			y2axis.resize(n);
+			decomposition.resize(n);
+			u.resize(n);
+			y2last.resize(n);
+		}
 	};
 }
 
@@ -1,5 +1,6 @@
 #include "rates/accrued.hpp"
 #include "rates/bond.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/value.hpp"
 #include "rates/yield_curve.hpp"
 
@@ -50,6 +51,33 @@ namespace rates
 		return value(curve.valueDate(), curve);
 	}
 
+	double Bond::value(const YieldCurve& curve, std::span<double> deltas) const
+	{
+		return rates::value(curve.valueDate(), curve, schedule_, dayCount_, couponRate_, notional_, deltas);
+	}
+
+	double Bond::valueDerivative(const YieldCurve& curve) const
+	{
+		return rates::valueDerivative(curve.valueDate(), curve, schedule_, dayCount_, couponRate_, notional_);
+	}
+
+	double Bond::value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		// A bond has no floating rates to project.
+		return value(discountCurve);
+	}
+
+	double Bond::valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		// A bond does not depend on the forward curve.
+		return 0.0;
+	}
+
+	void Bond::values(const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		rates::values(curves.valueDate(), curves, schedule_, dayCount_, couponRate_, notional_, pvs);
+	}
+
 	double Bond::value(const year_month_day& valueDate, double yield) const
 	{
 		return rates::value(valueDate, yield, schedule_, dayCount_, couponRate_, notional_, couponFrequency_);
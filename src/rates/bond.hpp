@@ -17,6 +17,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	class Bond : public Instrument
 	{
@@ -73,6 +74,11 @@ namespace rates
 
 		double value(const year_month_day& valueDate, const YieldCurve& curve) const;
 		virtual double value(const YieldCurve& curve) const override;
+		virtual double valueDerivative(const YieldCurve& curve) const override;
+		virtual double value(const YieldCurve& curve, std::span<double> deltas) const override;
+		virtual double value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual double valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual void values(const ScenarioCurves& curves, std::span<double> pvs) const override;
 		double value(const year_month_day& valueDate, double yield) const;
 		double yield(const year_month_day& valueDate, double price) const;
 
@@ -0,0 +1,54 @@
+#ifndef __jetblack__rates__bootstrap_report_hpp
+#define __jetblack__rates__bootstrap_report_hpp
+
+#include <chrono>
+#include <vector>
+
+namespace rates
+{
+	using namespace std::chrono;
+
+	/*
+	 * How the zero rate for one instrument was solved.
+	 */
+	struct InstrumentSolveReport
+	{
+		year_month_day	maturityDate {};
+		double			zeroRate {0};
+		unsigned int	iterations {0}; // solver steps, over every attempt
+		unsigned int	evaluations {0}; // instrument valuations, over every attempt
+		double			residual {0}; // the instrument value at the last evaluation
+		double			minRate {0}; // the bracket of the last attempt
+		double			maxRate {0};
+		bool			usedBrent {false}; // Newton's method failed and Brent's method was used
+		bool			widenedBracket {false}; // the root was outside the bracket around the initial rate
+		nanoseconds		elapsed {0};
+	};
+
+	/*
+	 * What happened while a curve was bootstrapped. The interpolator counts are the constructions, which
+	 * allocate, and the in place additions of points, which usually do not. The allocations are the
+	 * constructions and the additions which grew the interpolator's storage.
+	 */
+	struct BootstrapReport
+	{
+		std::vector<InstrumentSolveReport>	instruments {};
+		unsigned int						interpolatorConstructions {0};
+		unsigned int						interpolatorAdditions {0};
+		unsigned int						interpolatorAllocations {0};
+		nanoseconds							interpolatorElapsed {0};
+		unsigned int						globalIterations {0}; // Newton steps of the global bootstrap
+		unsigned int						globalEvaluations {0}; // instrument valuations of the global bootstrap
+		nanoseconds							elapsed {0};
+
+		unsigned int evaluations() const
+		{
+			unsigned int total = globalEvaluations;
+			for (const auto& instrument : instruments)
+				total += instrument.evaluations;
+			return total;
+		}
+	};
+}
+
+#endif // __jetblack__rates__bootstrap_report_hpp
@@ -0,0 +1,106 @@
+#include "rates/compiled_yield_curve.hpp"
+#include "rates/yield_curve.hpp"
+
+#include "maths/piecewise_polynomial.hpp"
+
+#include <stdexcept>
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	namespace
+	{
+		/*
+		 * Given a zero rate polynomial r = a + b dt + c dt^2 + d dt^3 about the origin x, the log discount
+		 * factor is (x + dt) * r.
+		 */
+		std::array<double, CompiledYieldCurve::Order> logDiscountCoefficients(double x, double a, double b, double c, double d)
+		{
+			return { a * x, a + b * x, b + c * x, c + d * x, d };
+		}
+	}
+
+	CompiledYieldCurve::CompiledYieldCurve(const YieldCurve& curve)
+		:	valueDate_(curve.valueDate()),
+			dayCount_(curve.dayCount()),
+			timeGrid_(curve.timeGrid() ? curve.timeGrid() : TimeGrid::shared(curve.valueDate(), curve.dayCount()))
+	{
+		if (curve.isSpreadView())
+			throw std::invalid_argument("a spread view cannot be compiled");
+
+		if (curve.points().empty())
+			throw std::range_error("no points in curve");
+
+		// The regions are converted from the segments the curve itself evaluates, so there is one set of coefficients.
+		using Transform = maths::PiecewisePolynomial::Transform;
+		const auto& table = curve.interpolationTable();
+		form_ = table.transform == Transform::Exp ? EForm::LogRate : EForm::LogDiscountFactor;
+		knots_ = table.knots;
+
+		auto append = [this](double origin, const std::array<double, Order>& c)
+		{
+			origins_.push_back(origin);
+			for (size_t i = 0; i < Order; ++i)
+				coefficients_[i].push_back(c[i]);
+		};
+
+		auto appendFlat = [&](double r)
+		{
+			if (form_ == EForm::LogRate)
+				append(0.0, { std::log(r), 0, 0, 0, 0 });
+			else
+				append(0.0, logDiscountCoefficients(0.0, r, 0, 0, 0));
+		};
+
+		auto appendSegment = [&](size_t j)
+		{
+			const double* c = table.segment(j);
+			switch (table.transform)
+			{
+			case Transform::OverX:	// the polynomial is the rate times the time
+			case Transform::Exp:	// the polynomial is the log of the rate
+				append(knots_[j], { c[0], c[1], c[2], c[3], 0 });
+				break;
+
+			default:
+				append(knots_[j], logDiscountCoefficients(knots_[j], c[0], c[1], c[2], c[3]));
+				break;
+			}
+		};
+
+		size_t n = knots_.size();
+		if (n == 1)
+		{
+			appendFlat(table.values.front());
+			appendFlat(table.values.front());
+			return;
+		}
+
+		if (table.flat_left)
+			appendFlat(table.values.front());
+		else
+			appendSegment(0);
+
+		for (size_t j = 0; j < n - 1; ++j)
+			appendSegment(j);
+
+		if (table.flat_right)
+			appendFlat(table.values.back());
+		else
+			appendSegment(n - 2);
+	}
+
+	double CompiledYieldCurve::fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const
+	{
+		if (firstAccrualDate == maturityDate)
+			return 0.0;
+
+		double t1 = time(firstAccrualDate);
+		double t2 = time(maturityDate);
+		double period_t = yearFrac(firstAccrualDate, maturityDate, dayCount);
+
+		return (exp(logDiscountFactor(t2) - logDiscountFactor(t1)) - 1.0) / period_t;
+	}
+}
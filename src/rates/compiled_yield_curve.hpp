@@ -0,0 +1,158 @@
+#ifndef __jetblack__rates__compiled_yield_curve_hpp
+#define __jetblack__rates__compiled_yield_curve_hpp
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "dates/terms.hpp"
+
+#include "rates/time_grid.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	class YieldCurve;
+
+	/*
+	 * A frozen, read-only snapshot of a built yield curve.
+	 *
+	 * The table of the curve's interpolator is compiled into a piecewise polynomial of the log discount
+	 * factor L(t) = r(t) * t, stored in structure-of-arrays form. Region k holds the times t with
+	 * knots[k-1] <= t < knots[k], with region 0 to the left of the first knot and region n to the right
+	 * of the last. Each region has an origin, and p(t) = c0 + c1 dt + c2 dt^2 + c3 dt^3 + c4 dt^4 where
+	 * dt = t - origin. The log discount factor is p itself, except for exponential interpolation, where
+	 * p is the log of the rate and L(t) = t exp(p(t)).
+	 *
+	 * Dates are resolved to times through the time grid of the curve, which is shared with it.
+	 *
+	 * The object is never modified after construction, so it can be shared between threads without locks.
+	 */
+
+	class CompiledYieldCurve
+	{
+	public:
+		static constexpr size_t Order = 5;
+
+		// How the polynomial of a region gives the log discount factor.
+		enum class EForm : std::uint32_t
+		{
+			LogDiscountFactor,	// L(t) = p(t)
+			LogRate				// L(t) = t exp(p(t))
+		};
+
+	private:
+		year_month_day							valueDate_ {};
+		EDayCount								dayCount_ {EDayCount::Actual_d365};
+		std::shared_ptr<const TimeGrid>			timeGrid_ {};
+		EForm									form_ {EForm::LogDiscountFactor};
+		std::vector<double>						knots_ {};
+		std::vector<double>						origins_ {};
+		std::array<std::vector<double>, Order>	coefficients_ {};
+
+	public:
+		CompiledYieldCurve() = default;
+
+		explicit CompiledYieldCurve(const YieldCurve& curve);
+
+		const year_month_day& valueDate() const { return valueDate_; }
+		EDayCount dayCount() const { return dayCount_; }
+		const std::shared_ptr<const TimeGrid>& timeGrid() const { return timeGrid_; }
+		EForm form() const { return form_; }
+		const std::vector<double>& knots() const { return knots_; }
+		const std::vector<double>& origins() const { return origins_; }
+		const std::vector<double>& coefficients(size_t power) const { return coefficients_.at(power); }
+
+		double logDiscountFactor(double t) const
+		{
+			return logDiscountFactor(
+				form_,
+				knots_,
+				origins_.data(),
+				{ coefficients_[0].data(), coefficients_[1].data(), coefficients_[2].data(), coefficients_[3].data(), coefficients_[4].data() },
+				t);
+		}
+
+		// The evaluation over bare tables, which is shared with tables held elsewhere, such as a mapped snapshot.
+		static double logDiscountFactor(
+			EForm form,
+			std::span<const double> knots,
+			const double* origins,
+			const std::array<const double*, Order>& coefficients,
+			double t)
+		{
+			size_t k = static_cast<size_t>(std::upper_bound(knots.begin(), knots.end(), t) - knots.begin());
+			double dt = t - origins[k];
+			double p = coefficients[0][k] + dt * (coefficients[1][k] + dt * (coefficients[2][k] + dt * (coefficients[3][k] + dt * coefficients[4][k])));
+			return form == EForm::LogRate ? t * std::exp(p) : p;
+		}
+
+		double rate(double t) const
+		{
+			if (t < 0.0)
+				throw std::range_error("time is prior to value date");
+
+			// To the left of the first knot the rate is flat, which avoids dividing by a zero time.
+			if (t <= knots_.front())
+				return firstRate();
+
+			return logDiscountFactor(t) / t;
+		}
+
+		double forwardRate(double t1, double t2) const
+		{
+			if (knots_.size() == 1)
+				return firstRate();
+
+			if (t1 == t2) return 0.0;
+
+			return (logDiscountFactor(t2) - logDiscountFactor(t1)) / (t2 - t1);
+		}
+
+		double discountFactor(double t) const
+		{
+			if (t < 0.0)
+				throw std::range_error("time is prior to value date");
+
+			return std::exp(-logDiscountFactor(t));
+		}
+
+		double discountFactor(double t1, double t2) const
+		{
+			if (t1 < 0.0 || t2 < 0.0)
+				throw std::range_error("time is prior to value date");
+
+			return std::exp(logDiscountFactor(t1) - logDiscountFactor(t2));
+		}
+
+		double rate(const year_month_day& date) const { return rate(time(date)); }
+		double forwardRate(const year_month_day& d1, const year_month_day& d2) const { return forwardRate(time(d1), time(d2)); }
+		double discountFactor(const year_month_day& date) const { return discountFactor(time(date)); }
+		double discountFactor(const year_month_day& d1, const year_month_day& d2) const { return discountFactor(time(d1), time(d2)); }
+
+		double fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const;
+
+		double time(const year_month_day& date) const
+		{
+			return timeGrid_ ? timeGrid_->time(date) : yearFrac(valueDate_, date, dayCount_);
+		}
+
+	private:
+		// The rate of region 0, which is flat from the value date to the first knot.
+		double firstRate() const
+		{
+			return form_ == EForm::LogRate ? std::exp(coefficients_[0].front()) : coefficients_[1].front();
+		}
+
+	};
+}
+
+#endif // __jetblack__rates__compiled_yield_curve_hpp
@@ -1,4 +1,5 @@
 #include "rates/deposit.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/yield_curve.hpp"
 
 #include "NR/root_secant.hpp"
@@ -56,6 +57,56 @@ namespace rates
 		return npv;
 	}
 
+	double Deposit::value(const YieldCurve& curve, std::span<double> deltas) const
+	{
+		double t = yearFrac(firstAccrualDate_, maturityDate_, dayCount_);
+		double endCashFlow = notional_ + notional_ * rate_ * t;
+
+		double dfStart = curve.discountFactor(firstAccrualDate_, deltas, -notional_);
+		double dfEnd = curve.discountFactor(maturityDate_, deltas, endCashFlow);
+
+		return endCashFlow * dfEnd - notional_ * dfStart;
+	}
+
+	double Deposit::valueDerivative(const YieldCurve& curve) const
+	{
+		double dDfStart = curve.discountFactorDerivative(firstAccrualDate_);
+		double dDfEnd = curve.discountFactorDerivative(maturityDate_);
+		double t = yearFrac(firstAccrualDate_, maturityDate_, dayCount_);
+
+		double endCashFlow = notional_ * (1.0 + rate_ * t);
+
+		return endCashFlow * dDfEnd - notional_ * dDfStart;
+	}
+
+	double Deposit::value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		// The deposit rate is exchanged for the rate projected over the deposit, paid at maturity.
+		double t = yearFrac(firstAccrualDate_, maturityDate_, dayCount_);
+		double fixingRate = forwardCurve.fix(firstAccrualDate_, maturityDate_, dayCount_);
+		return notional_ * (rate_ - fixingRate) * t * discountCurve.discountFactor(maturityDate_);
+	}
+
+	double Deposit::valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		double t = yearFrac(firstAccrualDate_, maturityDate_, dayCount_);
+		double dFixingRate = forwardCurve.fixDerivative(firstAccrualDate_, maturityDate_, dayCount_);
+		return -notional_ * dFixingRate * t * discountCurve.discountFactor(maturityDate_);
+	}
+
+	void Deposit::values(const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		std::vector<double> dfStart(curves.scenarioCount());
+		curves.discountFactors(firstAccrualDate_, dfStart);
+		curves.discountFactors(maturityDate_, pvs);
+
+		double t = yearFrac(firstAccrualDate_, maturityDate_, dayCount_);
+		double endCashFlow = notional_ + notional_ * rate_ * t;
+
+		for (size_t s = 0; s < pvs.size(); ++s)
+			pvs[s] = endCashFlow * pvs[s] - notional_ * dfStart[s];
+	}
+
 	double Deposit::calculateZeroRate(const YieldCurve& curve) const
 	{
 		double df = curve.discountFactor(firstAccrualDate_);
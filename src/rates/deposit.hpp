@@ -15,6 +15,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	/*
 	 * Deposit rate is a payment of $1 on the start date and receipt of $1 plus interest on the end date.
@@ -62,6 +63,11 @@ namespace rates
 		virtual void rate(double rate) override { rate_ = rate; }
 
 		virtual double value(const YieldCurve& curve) const override;
+		virtual double valueDerivative(const YieldCurve& curve) const override;
+		virtual double value(const YieldCurve& curve, std::span<double> deltas) const override;
+		virtual double value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual double valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual void values(const ScenarioCurves& curves, std::span<double> pvs) const override;
 		double calculateZeroRate(const YieldCurve& curve) const;
 
 		virtual std::shared_ptr<Instrument> clone_shared() const override
@@ -0,0 +1,163 @@
+#ifndef __jetblack__rates__forward_strip_hpp
+#define __jetblack__rates__forward_strip_hpp
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "dates/terms.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	/*
+	 * The fixing rates of a curve, keyed by the start date, end date and day count of the period.
+	 *
+	 * Each rate is computed the first time it is asked for and then read from the table, which is a
+	 * fixed size open addressed hash table. A thread claims an empty slot with a compare and swap,
+	 * publishes the key, computes the rate, and marks it ready. No locks are taken: a thread which
+	 * finds its key still being written waits for the rate rather than computing it again, so each
+	 * period takes one slot. When the probes run out the rate is computed without being stored. This
+	 * is counted as an overflow, and a strip which overflows needs more capacity.
+	 */
+
+	class ForwardStrip
+	{
+	public:
+		static constexpr size_t DefaultCapacity = 1024;
+		static constexpr size_t MaxProbes = 16;
+
+	private:
+		enum : std::uint32_t
+		{
+			Empty,
+			Claimed, // the key is being written
+			Writing, // the key is published and the rate is being computed
+			Ready,
+			Abandoned // computing the rate threw
+		};
+
+		struct Slot
+		{
+			std::atomic<std::uint32_t>	state {Empty};
+			std::int32_t				firstAccrualDate {0};
+			std::int32_t				maturityDate {0};
+			EDayCount					dayCount {EDayCount::Actual_d365};
+			double						rate {0};
+		};
+
+		std::unique_ptr<Slot[]>		slots_;
+		size_t						mask_;
+		std::atomic<size_t>			size_ {0};
+		std::atomic<size_t>			hits_ {0};
+		std::atomic<size_t>			misses_ {0};
+		std::atomic<size_t>			overflows_ {0};
+
+	public:
+		explicit ForwardStrip(size_t capacity = DefaultCapacity)
+		{
+			if (capacity == 0)
+				throw std::invalid_argument("the capacity must be positive");
+
+			capacity = std::bit_ceil(capacity);
+			slots_ = std::make_unique<Slot[]>(capacity);
+			mask_ = capacity - 1;
+		}
+
+		ForwardStrip(const ForwardStrip&) = delete;
+		ForwardStrip& operator=(const ForwardStrip&) = delete;
+
+		// The rate for the period, calling compute to find it when it is not in the table.
+		template <typename F>
+		double fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount, F&& compute)
+		{
+			auto d1 = static_cast<std::int32_t>(sys_days(firstAccrualDate).time_since_epoch().count());
+			auto d2 = static_cast<std::int32_t>(sys_days(maturityDate).time_since_epoch().count());
+
+			size_t h = hash(d1, d2, dayCount);
+			for (size_t probe = 0; probe < MaxProbes && probe <= mask_;)
+			{
+				Slot& slot = slots_[(h + probe) & mask_];
+
+				auto state = slot.state.load(std::memory_order_acquire);
+				if (state == Empty && slot.state.compare_exchange_strong(state, Claimed, std::memory_order_acquire))
+				{
+					slot.firstAccrualDate = d1;
+					slot.maturityDate = d2;
+					slot.dayCount = dayCount;
+					slot.state.store(Writing, std::memory_order_release);
+
+					double rate;
+					try
+					{
+						rate = compute();
+					}
+					catch (...)
+					{
+						slot.state.store(Abandoned, std::memory_order_release);
+						throw;
+					}
+
+					slot.rate = rate;
+					slot.state.store(Ready, std::memory_order_release);
+					size_.fetch_add(1, std::memory_order_relaxed);
+					misses_.fetch_add(1, std::memory_order_relaxed);
+					return rate;
+				}
+
+				// The key is only read once it has been published, and then it does not change.
+				if (state == Claimed)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				if ((state == Writing || state == Ready) && slot.firstAccrualDate == d1 && slot.maturityDate == d2 && slot.dayCount == dayCount)
+				{
+					if (state == Writing)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+
+					hits_.fetch_add(1, std::memory_order_relaxed);
+					return slot.rate;
+				}
+
+				++probe;
+			}
+
+			misses_.fetch_add(1, std::memory_order_relaxed);
+			overflows_.fetch_add(1, std::memory_order_relaxed);
+			return compute();
+		}
+
+		size_t size() const { return size_.load(std::memory_order_relaxed); }
+		size_t capacity() const { return mask_ + 1; }
+		// The lookups which found the rate in the table.
+		size_t hits() const { return hits_.load(std::memory_order_relaxed); }
+		// The lookups which computed the rate, including the overflows.
+		size_t misses() const { return misses_.load(std::memory_order_relaxed); }
+		// The lookups which computed the rate without storing it, because there was no slot for it.
+		size_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+	private:
+		static size_t hash(std::int32_t d1, std::int32_t d2, EDayCount dayCount)
+		{
+			auto x = static_cast<std::uint64_t>(static_cast<std::uint32_t>(d1)) << 32
+				| static_cast<std::uint32_t>(d2 * 16 + static_cast<int>(dayCount));
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdULL;
+			x ^= x >> 33;
+			return static_cast<size_t>(x);
+		}
+	};
+}
+
+#endif // __jetblack__rates__forward_strip_hpp
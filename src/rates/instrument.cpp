@@ -1,22 +1,101 @@
 #include "rates/instrument.hpp"
+#include "rates/bootstrap_report.hpp"
 #include "rates/yield_curve.hpp"
 
 #include "maths/brent.hpp"
+#include "maths/newton.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
 
 namespace rates
 {
+	double Instrument::bootstrapValue(const YieldCurve& curve) const
+	{
+		return curve.isProjectionCurve() ? value(curve.discountCurve(), curve) : value(curve);
+	}
+
+	double Instrument::bootstrapValueDerivative(const YieldCurve& curve) const
+	{
+		return curve.isProjectionCurve() ? valueDerivative(curve.discountCurve(), curve) : valueDerivative(curve);
+	}
+
 	double Instrument::solveZeroRate(
 		YieldCurve& curve,
 		unsigned int maxIterations,
-		double errorTolerance) const
+		double errorTolerance,
+		double minRate,
+		double maxRate,
+		InstrumentSolveReport* report) const
 	{
-		return maths::brent::solve(
-			[&](double rate)
+		unsigned int iterations = 0;
+		unsigned int evaluations = 0;
+		double residual = 0.0;
+		bool usedBrent = false;
+
+		auto record = [&](double zeroRate)
+		{
+			if (report != nullptr)
+			{
+				report->maturityDate = maturityDate();
+				report->zeroRate = zeroRate;
+				report->iterations += iterations;
+				report->evaluations += evaluations;
+				report->residual = residual;
+				report->minRate = minRate;
+				report->maxRate = maxRate;
+				report->usedBrent = usedBrent;
+			}
+			return zeroRate;
+		};
+
+		try
+		{
+			// Start from the current rate of the last point, using the analytic derivative.
+			return record(
+				maths::newton::solve(
+					[&](double rate)
+					{
+						++iterations;
+						++evaluations;
+						curve.setLastRate(rate);
+						residual = bootstrapValue(curve);
+						return std::make_pair(residual, bootstrapValueDerivative(curve));
+					},
+					curve.points().back().rate(), minRate, maxRate, maxIterations, errorTolerance
+				));
+		}
+		catch (const std::range_error&)
+		{
+			usedBrent = true;
+
+			auto of = [&](double rate)
 			{
+				++evaluations;
 				curve.setLastRate(rate);
-				return value(curve);
-			},
-			-0.1, 1.0, maxIterations, errorTolerance
-		);
+				return residual = bootstrapValue(curve);
+			};
+
+			// Brent needs the root to be bracketed.
+			if (std::signbit(of(minRate)) == std::signbit(of(maxRate)))
+			{
+				record(curve.points().back().rate());
+				throw std::range_error("root not bracketed");
+			}
+
+			// Brent's method starts by valuing both ends of the bracket, and then values once a step.
+			unsigned int brentEvaluations = 0;
+			return record(
+				maths::brent::solve(
+					[&](double rate)
+					{
+						if (++brentEvaluations > 2)
+							++iterations;
+						return of(rate);
+					},
+					minRate, maxRate, maxIterations, errorTolerance
+				));
+		}
 	}
 }
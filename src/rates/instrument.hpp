@@ -4,12 +4,15 @@
 #include <chrono>
 #include <limits>
 #include <memory>
+#include <span>
 
 namespace rates
 {
 	using namespace std::chrono;
 
     class YieldCurve;
+    class ScenarioCurves;
+    struct InstrumentSolveReport;
 
     class Instrument
     {
@@ -25,10 +28,31 @@ namespace rates
 		virtual void rate(double rate) = 0;
 
 		virtual double value(const YieldCurve& curve) const = 0;
+		// The derivative of the value with respect to the zero rate of the last point of the curve.
+		virtual double valueDerivative(const YieldCurve& curve) const = 0;
+		// The value, adding its sensitivity to the zero rate of each point of the curve to deltas as it goes.
+		virtual double value(const YieldCurve& curve, std::span<double> deltas) const = 0;
+		/*
+		 * The value with the cash flows discounted by one curve and the floating rates projected from another,
+		 * and its derivative with respect to the zero rate of the last point of the forward curve. The curves
+		 * are always treated as two curves, even when they are the same object; the single curve value is
+		 * value(curve).
+		 */
+		virtual double value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const = 0;
+		virtual double valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const = 0;
+		// The value on a curve being bootstrapped, and its derivative, which are the single curve ones unless the
+		// curve is a projection curve, when the cash flows are discounted by its discount curve.
+		double bootstrapValue(const YieldCurve& curve) const;
+		double bootstrapValueDerivative(const YieldCurve& curve) const;
+		// The value in each scenario.
+		virtual void values(const ScenarioCurves& curves, std::span<double> pvs) const = 0;
 		double solveZeroRate(
             YieldCurve& curve,
             unsigned int maxIterations = 100,
-            double errorTolerance = std::numeric_limits<double>::epsilon()
+            double errorTolerance = std::numeric_limits<double>::epsilon(),
+            double minRate = -0.1,
+            double maxRate = 1.0,
+            InstrumentSolveReport* report = nullptr
         ) const;
 
         virtual std::shared_ptr<Instrument> clone_shared() const = 0;
@@ -1,4 +1,5 @@
 #include "rates/ir_future.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/yield_curve.hpp"
 
 #include "maths/brent.hpp"
@@ -53,6 +54,31 @@ namespace rates
 		return deposit_.value(curve);
 	}
 
+	double IrFuture::value(const YieldCurve& curve, std::span<double> deltas) const
+	{
+		return deposit_.value(curve, deltas);
+	}
+
+	double IrFuture::valueDerivative(const YieldCurve& curve) const
+	{
+		return deposit_.valueDerivative(curve);
+	}
+
+	double IrFuture::value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return deposit_.value(discountCurve, forwardCurve);
+	}
+
+	double IrFuture::valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return deposit_.valueDerivative(discountCurve, forwardCurve);
+	}
+
+	void IrFuture::values(const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		deposit_.values(curves, pvs);
+	}
+
 	double IrFuture::calculateZeroRate(const YieldCurve& curve) const
 	{
 		return deposit_.calculateZeroRate(curve);
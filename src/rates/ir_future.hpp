@@ -16,6 +16,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	/*
 	 * An interest rate future is just a deposit, which begins spot days after the expiry of the future and ends three 
@@ -66,6 +67,11 @@ namespace rates
 		virtual void rate(double rate) override { deposit_.rate(rate); }
 
 		virtual double value(const YieldCurve& curve) const override;
+		virtual double valueDerivative(const YieldCurve& curve) const override;
+		virtual double value(const YieldCurve& curve, std::span<double> deltas) const override;
+		virtual double value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual double valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		virtual void values(const ScenarioCurves& curves, std::span<double> pvs) const override;
 		double calculateZeroRate(const YieldCurve& curve) const;
 
 		virtual std::shared_ptr<Instrument> clone_shared() const override
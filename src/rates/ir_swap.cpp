@@ -1,9 +1,11 @@
 #include "rates/ir_swap.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/yield_curve.hpp"
 
 #include "maths/brent.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace rates
 {
@@ -95,9 +97,7 @@ namespace rates
 
 	double IrSwap::value(const year_month_day& valueDate, const YieldCurve& curve) const
 	{
-		double fixedPV = fixedLeg_.value(valueDate, curve);
-		double floatingPV = floatingLeg_.value(valueDate, curve);
-		return fixedPV - floatingPV;
+		return fixedLeg_.value(valueDate, curve) - floatingLeg_.value(valueDate, curve);
 	}
 
 	double IrSwap::value(const YieldCurve& curve) const
@@ -105,6 +105,72 @@ namespace rates
 		return value(curve.valueDate(), curve);
 	}
 
+	double IrSwap::valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const
+	{
+		return fixedLeg_.valueDerivative(valueDate, curve) - floatingLeg_.valueDerivative(valueDate, curve);
+	}
+
+	double IrSwap::valueDerivative(const YieldCurve& curve) const
+	{
+		return valueDerivative(curve.valueDate(), curve);
+	}
+
+	double IrSwap::value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const
+	{
+		// The floating leg is paid, so its deltas are found separately and subtracted.
+		std::vector<double> floatingDeltas(deltas.size());
+		double fixedPV = fixedLeg_.value(valueDate, curve, deltas);
+		double floatingPV = floatingLeg_.value(valueDate, curve, floatingDeltas);
+
+		for (size_t i = 0; i < deltas.size(); ++i)
+			deltas[i] -= floatingDeltas[i];
+
+		return fixedPV - floatingPV;
+	}
+
+	double IrSwap::value(const YieldCurve& curve, std::span<double> deltas) const
+	{
+		return value(curve.valueDate(), curve, deltas);
+	}
+
+	double IrSwap::value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		double fixedPV = fixedLeg_.value(valueDate, discountCurve, forwardCurve);
+		double floatingPV = floatingLeg_.value(valueDate, discountCurve, forwardCurve);
+		return fixedPV - floatingPV;
+	}
+
+	double IrSwap::value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return value(discountCurve.valueDate(), discountCurve, forwardCurve);
+	}
+
+	double IrSwap::valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return fixedLeg_.valueDerivative(valueDate, discountCurve, forwardCurve)
+			- floatingLeg_.valueDerivative(valueDate, discountCurve, forwardCurve);
+	}
+
+	double IrSwap::valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return valueDerivative(discountCurve.valueDate(), discountCurve, forwardCurve);
+	}
+
+	void IrSwap::values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		std::vector<double> floatingPVs(pvs.size());
+		fixedLeg_.values(valueDate, curves, pvs);
+		floatingLeg_.values(valueDate, curves, floatingPVs);
+
+		for (size_t s = 0; s < pvs.size(); ++s)
+			pvs[s] -= floatingPVs[s];
+	}
+
+	void IrSwap::values(const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		values(curves.valueDate(), curves, pvs);
+	}
+
 	double IrSwap::calculateZeroRate(const YieldCurve& curve) const
 	{
 		// Ignore the floating side - we only care about the fixed leg
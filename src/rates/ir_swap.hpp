@@ -14,6 +14,7 @@ namespace rates
 	using namespace std::chrono;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	class IrSwap : public Instrument
 	{
@@ -60,6 +61,16 @@ namespace rates
 
 		virtual double value(const YieldCurve& curve) const override;
 		double value(const year_month_day& valueDate, const YieldCurve& curve) const;
+		virtual double valueDerivative(const YieldCurve& curve) const override;
+		double valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const;
+		virtual double value(const YieldCurve& curve, std::span<double> deltas) const override;
+		double value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const;
+		virtual double value(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		double value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual double valueDerivative(const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const override;
+		double valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual void values(const ScenarioCurves& curves, std::span<double> pvs) const override;
+		void values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const;
 
 		IrSwapLegFixed& fixedLeg() { return fixedLeg_; }
 		const IrSwapLegFixed& fixedLeg() const { return fixedLeg_; }
@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <set>
+#include <span>
 #include <vector>
 
 #include "dates/schedules.hpp"
@@ -15,6 +16,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	class IrSwapLeg
 	{
@@ -54,6 +56,14 @@ namespace rates
 		virtual double value(const year_month_day& valueDate, const YieldCurve& curve) const = 0;
 		virtual double value(const YieldCurve& curve) const = 0;
 		virtual double accrued(const YieldCurve& curve, const year_month_day& valueDate) const = 0;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const = 0;
+		// The value, adding its sensitivity to the zero rate of each point of the curve to deltas.
+		virtual double value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const = 0;
+		// The value with the cash flows discounted by one curve and the floating rates projected from another,
+		// and its derivative with respect to the zero rate of the last point of the forward curve.
+		virtual double value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const = 0;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const = 0;
+		virtual void values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const = 0;
 
 		double notional() const { return notional_; }
 		const year_month_day& firstAccrualDate() const { return firstAccrualDate_; }
@@ -1,6 +1,7 @@
 #include "rates/accrued.hpp"
 #include "rates/ir_swap_leg_fixed.hpp"
 #include "rates/ir_swap.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/value.hpp"
 #include "rates/yield_curve.hpp"
 
@@ -56,6 +57,32 @@ namespace rates
 		return value(curve.valueDate(), curve);
 	}
 
+	double IrSwapLegFixed::value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const
+	{
+		return rates::value(valueDate, curve, schedule_, dayCount_, rate_, notional_, deltas);
+	}
+
+	double IrSwapLegFixed::valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const
+	{
+		return rates::valueDerivative(valueDate, curve, schedule_, dayCount_, rate_, notional_);
+	}
+
+	double IrSwapLegFixed::value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		return value(valueDate, discountCurve);
+	}
+
+	double IrSwapLegFixed::valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		// The fixed leg does not depend on the forward curve.
+		return 0.0;
+	}
+
+	void IrSwapLegFixed::values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		rates::values(valueDate, curves, schedule_, dayCount_, rate_, notional_, pvs);
+	}
+
 	double IrSwapLegFixed::calculateZeroRate(const YieldCurve& curve) const
 	{
 		double x = 1.0;
@@ -68,14 +95,19 @@ namespace rates
 		}
 		else
 		{
+			// The schedule is in order, so the rate lookups walk the curve once.
 			std::vector<year_month_day>::const_iterator i_date(schedule_.begin() + 1);
-			while (i_date != schedule_.end() - 1)
+			curve.withRates([&](auto rate)
 			{
-				auto t = yearFrac(*(i_date-1), *i_date, dayCount_);
-				auto df = curve.discountFactor(*i_date);
-				x = x - rate_ * df * t;
-				i_date++;
-			}
+				while (i_date != schedule_.end() - 1)
+				{
+					auto t = yearFrac(*(i_date-1), *i_date, dayCount_);
+					auto t_df = curve.time(*i_date);
+					auto df = exp(-rate(t_df) * t_df);
+					x = x - rate_ * df * t;
+					i_date++;
+				}
+			});
 
 			auto t = yearFrac(*(i_date-1), *i_date, dayCount_);
 			divisor = 1.0 + rate_ * t;
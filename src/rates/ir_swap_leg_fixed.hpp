@@ -15,6 +15,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	class IrSwapLegFixed : public IrSwapLeg
 	{
@@ -49,6 +50,11 @@ namespace rates
 		virtual double value(const year_month_day& valueDate, const YieldCurve& curve) const;
 		virtual double value(const YieldCurve& curve) const;
 		virtual double accrued(const YieldCurve& curve, const year_month_day& valueDate) const;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const;
+		virtual double value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const;
+		virtual double value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual void values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const;
 
 		double calculateZeroRate(const YieldCurve& curve) const;
 
@@ -1,6 +1,7 @@
 #include "rates/accrued.hpp"
 #include "rates/ir_swap_leg_floating.hpp"
 #include "rates/ir_swap.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/value.hpp"
 #include "rates/yield_curve.hpp"
 
@@ -89,6 +90,29 @@ namespace rates
 			| std::ranges::to<std::vector<double>>();
 	}
 
+	std::vector<double> IrSwapLegFloating::getFixingRateDerivatives(const YieldCurve& curve) const
+	{
+		return std::ranges::zip_view(schedule_, fixingSchedule_)
+			| std::views::transform(
+				[&](auto&& x)
+				{
+					auto& [firstAccrualDate, fixingDate] = x;
+					return curve.fixDerivative(firstAccrualDate, fixingDate, dayCount_);
+				})
+			| std::ranges::to<std::vector<double>>();
+	}
+
+	std::vector<double> IrSwapLegFloating::getFixingRates(const ScenarioCurves& curves) const
+	{
+		size_t m = curves.scenarioCount();
+		std::vector<double> fixingRates(fixingSchedule_.size() * m);
+
+		for (size_t i = 0; i < fixingSchedule_.size(); ++i)
+			curves.fix(schedule_[i], fixingSchedule_[i], dayCount_, std::span(fixingRates).subspan(i * m, m));
+
+		return fixingRates;
+	}
+
 	double IrSwapLegFloating::accrued(const YieldCurve& curve, const year_month_day& valueDate) const
 	{
 		auto fixingRates = getFixingRates(curve);
@@ -96,9 +120,47 @@ namespace rates
 	}
 
 	double IrSwapLegFloating::value(const year_month_day& valueDate, const YieldCurve& curve) const
+	{
+		return value(valueDate, curve, curve);
+	}
+
+	// The fixing rates are projected from the same curve, so their sensitivities are added to the deltas too.
+	double IrSwapLegFloating::value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const
+	{
+		auto fixingRates = getFixingRates(curve);
+		std::vector<double> fixingRateDeltas(fixingRates.size());
+		double pv = rates::value(valueDate, curve, schedule_, dayCount_, fixingRates, notional_, deltas, fixingRateDeltas);
+
+		for (auto &&[firstAccrualDate, fixingDate, fixingRateDelta] : std::views::zip(schedule_, fixingSchedule_, fixingRateDeltas))
+			curve.fix(firstAccrualDate, fixingDate, dayCount_, deltas, fixingRateDelta);
+
+		return pv;
+	}
+
+	// The fixing rates are projected from the same curve, so their derivatives move the cash flows too.
+	double IrSwapLegFloating::valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const
 	{
 		auto fixingRates = getFixingRates(curve);
-		return rates::value(valueDate, curve, schedule_, dayCount_, fixingRates, notional_);
+		auto fixingRateDerivatives = getFixingRateDerivatives(curve);
+		return rates::valueDerivative(valueDate, curve, schedule_, dayCount_, fixingRates, fixingRateDerivatives, notional_);
+	}
+
+	double IrSwapLegFloating::value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		auto fixingRates = getFixingRates(forwardCurve);
+		return rates::value(valueDate, discountCurve, schedule_, dayCount_, fixingRates, notional_);
+	}
+
+	double IrSwapLegFloating::valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const
+	{
+		auto fixingRateDerivatives = getFixingRateDerivatives(forwardCurve);
+		return rates::forwardValueDerivative(valueDate, discountCurve, schedule_, dayCount_, fixingRateDerivatives, notional_);
+	}
+
+	void IrSwapLegFloating::values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const
+	{
+		auto fixingRates = getFixingRates(curves);
+		rates::values(valueDate, curves, schedule_, dayCount_, fixingRates, notional_, pvs);
 	}
 
 	double IrSwapLegFloating::value(const YieldCurve& curve) const
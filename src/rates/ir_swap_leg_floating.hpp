@@ -17,6 +17,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	class IrSwapLegFloating : public IrSwapLeg
 	{
@@ -55,6 +56,11 @@ namespace rates
 		virtual double value(const year_month_day& valueDate, const YieldCurve& curve) const;
 		virtual double value(const YieldCurve& curve) const;
 		virtual double accrued(const YieldCurve& curve, const year_month_day& valueDate) const;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& curve) const;
+		virtual double value(const year_month_day& valueDate, const YieldCurve& curve, std::span<double> deltas) const;
+		virtual double value(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual double valueDerivative(const year_month_day& valueDate, const YieldCurve& discountCurve, const YieldCurve& forwardCurve) const;
+		virtual void values(const year_month_day& valueDate, const ScenarioCurves& curves, std::span<double> pvs) const;
 
 		std::pair<std::optional<double>,std::optional<double>> getCurrentFixings(const YieldCurve& curve, const year_month_day& valueDate) const;
 
@@ -64,6 +70,9 @@ namespace rates
 
 	private:
 		std::vector<double> getFixingRates(const YieldCurve& curve) const;
+		std::vector<double> getFixingRateDerivatives(const YieldCurve& curve) const;
+		// The fixing rates of every scenario, with the scenarios of each period together.
+		std::vector<double> getFixingRates(const ScenarioCurves& curves) const;
 	};
 }
 
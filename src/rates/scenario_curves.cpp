@@ -0,0 +1,135 @@
+#include "rates/scenario_curves.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "maths/simd.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	ScenarioCurves::ScenarioCurves(const YieldCurve& base, size_t scenarioCount)
+		:	timeGrid_(base.timeGrid()),
+			scenarioCount_(scenarioCount)
+	{
+		if (base.isSpreadView())
+			throw std::invalid_argument("a spread view cannot be the base of scenarios");
+
+		const auto& points = base.points();
+		if (points.empty())
+			throw std::range_error("no points in curve");
+
+		if (!timeGrid_)
+			throw std::invalid_argument("the base curve has no time grid");
+
+		if (base.interpolationMethod() == EInterpolationMethod::Exponential && points.size() > 1)
+			throw std::invalid_argument("exponential interpolation is not linear in the rates");
+
+		size_t n = points.size();
+		rates_.resize(n * scenarioCount_);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			times_.push_back(points[i].time());
+			std::ranges::fill(rates(i), points[i].rate());
+
+			auto unitPoints = points;
+			for (size_t j = 0; j < n; ++j)
+				unitPoints[j].rate(i == j ? 1.0 : 0.0);
+			unitCurves_.push_back(YieldCurve(unitPoints, base.valueDate(), base.dayCount(), base.interpolationMethod()));
+		}
+	}
+
+	void ScenarioCurves::setRates(size_t scenario, std::span<const double> rs)
+	{
+		if (scenario >= scenarioCount_)
+			throw std::out_of_range("no such scenario");
+
+		if (rs.size() != times_.size())
+			throw std::invalid_argument("there must be a rate for each point");
+
+		for (size_t i = 0; i < rs.size(); ++i)
+			rates_[i * scenarioCount_ + scenario] = rs[i];
+	}
+
+	void ScenarioCurves::weights(double t, std::span<double> ws) const
+	{
+		if (ws.size() != times_.size())
+			throw std::invalid_argument("there must be a weight for each point");
+
+		for (size_t i = 0; i < ws.size(); ++i)
+			ws[i] = unitCurves_[i].rate(t);
+	}
+
+	void ScenarioCurves::logDiscountFactors(double t, std::span<double> ls) const
+	{
+		if (ls.size() != scenarioCount_)
+			throw std::invalid_argument("there must be an output for each scenario");
+
+		std::vector<double> ws(times_.size());
+		weights(t, ws);
+
+		std::ranges::fill(ls, 0.0);
+
+		for (size_t i = 0; i < ws.size(); ++i)
+		{
+			// The local interpolators give most points no weight.
+			if (ws[i] == 0.0)
+				continue;
+
+			double w = ws[i] * t;
+			const double* r = rates_.data() + i * scenarioCount_;
+			for (size_t s = 0; s < scenarioCount_; ++s)
+				ls[s] += w * r[s];
+		}
+	}
+
+	void ScenarioCurves::discountFactors(double t, std::span<double> dfs) const
+	{
+		logDiscountFactors(t, dfs);
+
+		for (auto& df : dfs)
+			df = -df;
+		maths::simd::exp(dfs, dfs);
+	}
+
+	void ScenarioCurves::discountFactors(const year_month_day& date, std::span<double> dfs) const
+	{
+		discountFactors(time(date), dfs);
+	}
+
+	void ScenarioCurves::discountFactors(const year_month_day& d1, const year_month_day& d2, std::span<double> dfs) const
+	{
+		std::vector<double> l1(scenarioCount_);
+		logDiscountFactors(time(d1), l1);
+		logDiscountFactors(time(d2), dfs);
+
+		for (size_t s = 0; s < scenarioCount_; ++s)
+			dfs[s] = l1[s] - dfs[s];
+		maths::simd::exp(dfs, dfs);
+	}
+
+	void ScenarioCurves::fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount, std::span<double> fixings) const
+	{
+		if (firstAccrualDate == maturityDate)
+		{
+			std::ranges::fill(fixings, 0.0);
+			return;
+		}
+
+		std::vector<double> l1(scenarioCount_);
+		logDiscountFactors(time(firstAccrualDate), l1);
+		logDiscountFactors(time(maturityDate), fixings);
+
+		double period_t = yearFrac(firstAccrualDate, maturityDate, dayCount);
+
+		for (size_t s = 0; s < scenarioCount_; ++s)
+			fixings[s] = fixings[s] - l1[s];
+		maths::simd::exp(fixings, fixings);
+		for (size_t s = 0; s < scenarioCount_; ++s)
+			fixings[s] = (fixings[s] - 1.0) / period_t;
+	}
+}
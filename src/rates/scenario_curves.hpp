@@ -0,0 +1,68 @@
+#ifndef __jetblack__rates__scenario_curves_hpp
+#define __jetblack__rates__scenario_curves_hpp
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "dates/terms.hpp"
+
+#include "rates/time_grid.hpp"
+#include "rates/yield_curve.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	/*
+	 * A set of scenario curves which share the points, interpolation and time grid of a base curve and
+	 * differ only in their zero rates.
+	 *
+	 * The rates are stored with the scenarios of each point together, so rates(i)[s] is the rate of
+	 * point i in scenario s. Every supported interpolation is linear in the rates of the points, so the
+	 * rate at a time is a weighted sum of the point rates with weights that are the same for every
+	 * scenario. The weights are found once per time, and then all the scenarios are evaluated in one
+	 * pass over contiguous memory.
+	 */
+
+	class ScenarioCurves
+	{
+	private:
+		std::shared_ptr<const TimeGrid>	timeGrid_;
+		std::vector<double>				times_;
+		size_t							scenarioCount_;
+		std::vector<double>				rates_;
+		std::vector<YieldCurve>			unitCurves_; // The rate of unitCurves_[i] is the weight of point i.
+
+	public:
+		// All the scenarios start with the rates of the base curve.
+		ScenarioCurves(const YieldCurve& base, size_t scenarioCount);
+
+		const year_month_day& valueDate() const { return timeGrid_->valueDate(); }
+		const std::shared_ptr<const TimeGrid>& timeGrid() const { return timeGrid_; }
+		const std::vector<double>& times() const { return times_; }
+		size_t scenarioCount() const { return scenarioCount_; }
+
+		std::span<double> rates(size_t point) { return { rates_.data() + point * scenarioCount_, scenarioCount_ }; }
+		std::span<const double> rates(size_t point) const { return { rates_.data() + point * scenarioCount_, scenarioCount_ }; }
+		void setRates(size_t scenario, std::span<const double> rates);
+
+		void weights(double t, std::span<double> ws) const;
+
+		void discountFactors(double t, std::span<double> dfs) const;
+		void discountFactors(const year_month_day& date, std::span<double> dfs) const;
+		void discountFactors(const year_month_day& firstAccrualDate, const year_month_day& endDate, std::span<double> dfs) const;
+
+		void fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount, std::span<double> fixings) const;
+
+		double time(const year_month_day& date) const { return timeGrid_->time(date); }
+
+	private:
+		// The rate multiplied by the time, which is minus the log of the discount factor.
+		void logDiscountFactors(double t, std::span<double> ls) const;
+	};
+}
+
+#endif // __jetblack__rates__scenario_curves_hpp
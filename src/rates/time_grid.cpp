@@ -0,0 +1,102 @@
+#include "rates/time_grid.hpp"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	namespace
+	{
+		double fixedBasis(EDayCount dayCount)
+		{
+			switch (dayCount)
+			{
+			case EDayCount::Actual_d360:
+				return 360.0;
+			case EDayCount::Actual_d365:
+				return 365.0;
+			case EDayCount::Actual_d366:
+				return 366.0;
+			case EDayCount::Actual_d365_25:
+				return 365.25;
+			default:
+				return 0.0;
+			}
+		}
+	}
+
+	TimeGrid::TimeGrid(
+		const year_month_day& valueDate,
+		EDayCount dayCount,
+		int horizonDays)
+		:	valueDate_(valueDate),
+			dayCount_(dayCount),
+			origin_(valueDate),
+			basis_(fixedBasis(dayCount)),
+			horizonDays_(horizonDays)
+	{
+		if (horizonDays < 0)
+			throw std::invalid_argument("the horizon must not be negative");
+
+		if (basis_ == 0.0)
+			chunks_ = std::make_unique<Chunk[]>((horizonDays + ChunkDays - 1) / ChunkDays);
+	}
+
+	std::shared_ptr<const TimeGrid> TimeGrid::shared(const year_month_day& valueDate, EDayCount dayCount)
+	{
+		static std::mutex mutex;
+		static std::map<std::pair<int, EDayCount>, std::weak_ptr<const TimeGrid>> grids;
+
+		auto key = std::make_pair(sys_days{valueDate}.time_since_epoch().count(), dayCount);
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (auto grid = grids[key].lock())
+			return grid;
+
+		// Drop the grids no curve holds any more.
+		std::erase_if(grids, [](const auto& entry) { return entry.second.expired(); });
+
+		auto grid = std::make_shared<const TimeGrid>(valueDate, dayCount);
+		grids[key] = grid;
+		return grid;
+	}
+
+	void TimeGrid::times(std::span<const year_month_day> dates, std::span<double> ts) const
+	{
+		if (dates.size() != ts.size())
+			throw std::invalid_argument("input and output sizes differ");
+
+		for (size_t i = 0; i < dates.size(); ++i)
+			ts[i] = time(dates[i]);
+	}
+
+	std::vector<double> TimeGrid::times(std::span<const year_month_day> dates) const
+	{
+		std::vector<double> ts(dates.size());
+		times(dates, ts);
+		return ts;
+	}
+
+	const double* TimeGrid::chunk(int k) const
+	{
+		Chunk& c = chunks_[k];
+		std::call_once(
+			c.flag,
+			[this, &c, k]()
+			{
+				int first = k * ChunkDays;
+				int size = std::min(ChunkDays, horizonDays_ - first);
+				c.times = std::make_unique<double[]>(size);
+				for (int i = 0; i < size; ++i)
+					c.times[i] = yearFrac(valueDate_, year_month_day{origin_ + days{first + i}}, dayCount_);
+			});
+
+		return c.times.get();
+	}
+}
@@ -0,0 +1,95 @@
+#ifndef __jetblack__rates__time_grid_hpp
+#define __jetblack__rates__time_grid_hpp
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "dates/terms.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	/*
+	 * Converts dates to times in years from a value date.
+	 *
+	 * A date is first reduced to a serial day offset from the value date. Day counts with a fixed
+	 * denominator (Actual/360, Actual/365, Actual/366, Actual/365.25) are then closed form. The others are
+	 * looked up in a table indexed by the offset, which covers the horizon after the value date. The
+	 * table is filled a year at a time as dates in that year are first asked for, so a curve which
+	 * only looks at its first few years only pays for those. Dates outside the table fall back to yearFrac.
+	 *
+	 * The grid only changes by filling in its table, which is thread safe, so it can be shared between
+	 * curves and threads. Curves with the same value date and day count share one through shared().
+	 */
+
+	class TimeGrid
+	{
+	public:
+		static constexpr int DefaultHorizonDays = 366 * 60;
+		// The days filled in at a time.
+		static constexpr int ChunkDays = 366;
+
+	private:
+		struct Chunk
+		{
+			std::once_flag				flag;
+			std::unique_ptr<double[]>	times;
+		};
+
+		year_month_day					valueDate_;
+		EDayCount						dayCount_;
+		sys_days						origin_;
+		double							basis_; // The days in a year for fixed denominator day counts, otherwise zero.
+		int								horizonDays_;
+		mutable std::unique_ptr<Chunk[]>	chunks_;
+
+	public:
+		TimeGrid(
+			const year_month_day& valueDate,
+			EDayCount dayCount,
+			int horizonDays = DefaultHorizonDays);
+
+		TimeGrid(const TimeGrid&) = delete;
+		TimeGrid& operator=(const TimeGrid&) = delete;
+
+		// The grid for the value date and day count with the default horizon, shared with every other
+		// caller asking for the same one while any of them holds it.
+		static std::shared_ptr<const TimeGrid> shared(const year_month_day& valueDate, EDayCount dayCount);
+
+		const year_month_day& valueDate() const { return valueDate_; }
+		EDayCount dayCount() const { return dayCount_; }
+		int horizonDays() const { return horizonDays_; }
+		bool isClosedForm() const { return basis_ != 0.0; }
+
+		int dayOffset(const year_month_day& date) const
+		{
+			return (sys_days{date} - origin_).count();
+		}
+
+		double time(const year_month_day& date) const
+		{
+			int offset = dayOffset(date);
+
+			if (basis_ != 0.0)
+				return offset / basis_;
+
+			if (offset >= 0 && offset < horizonDays_)
+				return chunk(offset / ChunkDays)[offset % ChunkDays];
+
+			return yearFrac(valueDate_, date, dayCount_);
+		}
+
+		void times(std::span<const year_month_day> dates, std::span<double> ts) const;
+		std::vector<double> times(std::span<const year_month_day> dates) const;
+
+	private:
+		const double* chunk(int k) const;
+	};
+}
+
+#endif // __jetblack__rates__time_grid_hpp
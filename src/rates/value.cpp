@@ -1,10 +1,14 @@
 #include "rates/value.hpp"
+#include "rates/scenario_curves.hpp"
 #include "rates/yield_curve.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
+#include <utility>
 
 namespace rates
 {
@@ -12,8 +16,7 @@ namespace rates
 	using namespace dates;
 
 	static double value(
-		const year_month_day& valueDate,
-		const YieldCurve& curve,
+		double df,
 		const year_month_day& firstAccrualDate,
 		const year_month_day& endDate,
 		EDayCount dayCount,
@@ -21,22 +24,30 @@ namespace rates
 		double notional)
 	{
 		double t = yearFrac(firstAccrualDate, endDate, dayCount);
-		double df = curve.discountFactor(valueDate, endDate);
 		double amount = notional * rate * t;
 		double pv = amount * df;
 		return pv;
 	}
 
-	static double value(
+	// The discount factors from the value date to each end date of the schedule, found in one call to the
+	// curve. A schedule of one date has no periods, only the final payment on that date.
+	static std::vector<double> discountFactors(
 		const year_month_day& valueDate,
 		const YieldCurve& curve,
-		const year_month_day& endDate,
-		EDayCount dayCount,
-		double notional)
+		const std::vector<year_month_day>& schedule)
 	{
-		double df = curve.discountFactor(valueDate, endDate);
-		double pv = notional * df;
-		return pv;
+		if (schedule.empty())
+			throw std::invalid_argument("the schedule must have at least one date");
+
+		auto endDates = schedule.size() > 1 ? std::span(schedule).subspan(1) : std::span(schedule);
+		std::vector<double> dfs(endDates.size());
+		curve.discountFactors(endDates, dfs);
+
+		double df0 = curve.discountFactor(valueDate);
+		for (auto& df : dfs)
+			df /= df0;
+
+		return dfs;
 	}
 
 	double value(
@@ -47,17 +58,19 @@ namespace rates
 		double rate,
 		double notional)
 	{
+		auto dfs = discountFactors(valueDate, curve, schedule);
+
 		double sum_pv = 0.0;
 
 		for (
-			auto &&[firstAccrualDate, endDate]
-			: std::views::zip(schedule, schedule | std::views::drop(1)))
+			auto &&[firstAccrualDate, endDate, df]
+			: std::views::zip(schedule, schedule | std::views::drop(1), dfs))
 		{
-			auto coupon_pv = value(valueDate, curve, firstAccrualDate, endDate, dayCount, rate, notional);
+			auto coupon_pv = value(df, firstAccrualDate, endDate, dayCount, rate, notional);
 			sum_pv += coupon_pv;
 		}
 
-		auto notional_pv = value(valueDate, curve, schedule.back(), dayCount, notional);
+		auto notional_pv = notional * dfs.back();
 		sum_pv += notional_pv;
 
 		return sum_pv;
@@ -71,25 +84,272 @@ namespace rates
 		const std::vector<double>& fixingRates,
 		double notional)
 	{
+		auto dfs = discountFactors(valueDate, curve, schedule);
+
 		double sum_pv = 0;
 
 		for (
-			auto &&[firstAccrualDate, endDate, rate]
+			auto &&[firstAccrualDate, endDate, df, rate]
 			: std::views::zip(
 				schedule,
 				schedule | std::views::drop(1),
+				dfs,
 				fixingRates))
 		{
-			auto cashflow_pv = value(valueDate, curve, firstAccrualDate, endDate, dayCount, rate, notional);
+			auto cashflow_pv = value(df, firstAccrualDate, endDate, dayCount, rate, notional);
 			sum_pv += cashflow_pv;
 		}
 
-		auto notional_pv = value(valueDate, curve, schedule.back(), dayCount, notional);
+		auto notional_pv = notional * dfs.back();
 		sum_pv += notional_pv;
 
 		return sum_pv;
 	}
 
+	double value(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional,
+		std::span<double> deltas)
+	{
+		double df0 = curve.discountFactor(valueDate);
+
+		double sum_pv = 0.0;
+
+		for (auto &&[firstAccrualDate, endDate] : std::views::zip(schedule, schedule | std::views::drop(1)))
+		{
+			double amount = notional * rate * yearFrac(firstAccrualDate, endDate, dayCount);
+			sum_pv += amount * curve.discountFactor(endDate, deltas, amount / df0) / df0;
+		}
+
+		sum_pv += notional * curve.discountFactor(schedule.back(), deltas, notional / df0) / df0;
+
+		// Every discount factor is relative to the one at the value date.
+		curve.discountFactor(valueDate, deltas, -sum_pv / df0);
+
+		return sum_pv;
+	}
+
+	double value(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		double notional,
+		std::span<double> deltas,
+		std::span<double> fixingRateDeltas)
+	{
+		if (fixingRateDeltas.size() < fixingRates.size())
+			throw std::invalid_argument("there must be a sensitivity for each fixing rate");
+
+		double df0 = curve.discountFactor(valueDate);
+
+		double sum_pv = 0.0;
+
+		size_t periods = std::min(fixingRates.size(), schedule.size() - 1);
+		for (size_t i = 0; i < periods; ++i)
+		{
+			double t = yearFrac(schedule[i], schedule[i+1], dayCount);
+			double amount = notional * fixingRates[i] * t;
+			double df = curve.discountFactor(schedule[i+1], deltas, amount / df0) / df0;
+			fixingRateDeltas[i] = notional * t * df;
+			sum_pv += amount * df;
+		}
+
+		sum_pv += notional * curve.discountFactor(schedule.back(), deltas, notional / df0) / df0;
+
+		curve.discountFactor(valueDate, deltas, -sum_pv / df0);
+
+		return sum_pv;
+	}
+
+	void values(
+		const year_month_day& valueDate,
+		const ScenarioCurves& curves,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional,
+		std::span<double> pvs)
+	{
+		size_t m = curves.scenarioCount();
+		if (pvs.size() != m)
+			throw std::invalid_argument("there must be a value for each scenario");
+
+		std::ranges::fill(pvs, 0.0);
+		std::vector<double> dfs(m);
+
+		for (
+			auto &&[firstAccrualDate, endDate]
+			: std::views::zip(schedule, schedule | std::views::drop(1)))
+		{
+			double amount = notional * rate * yearFrac(firstAccrualDate, endDate, dayCount);
+			curves.discountFactors(valueDate, endDate, dfs);
+			for (size_t s = 0; s < m; ++s)
+				pvs[s] += amount * dfs[s];
+		}
+
+		curves.discountFactors(valueDate, schedule.back(), dfs);
+		for (size_t s = 0; s < m; ++s)
+			pvs[s] += notional * dfs[s];
+	}
+
+	void values(
+		const year_month_day& valueDate,
+		const ScenarioCurves& curves,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		double notional,
+		std::span<double> pvs)
+	{
+		size_t m = curves.scenarioCount();
+		if (pvs.size() != m)
+			throw std::invalid_argument("there must be a value for each scenario");
+
+		std::ranges::fill(pvs, 0.0);
+		std::vector<double> dfs(m);
+
+		for (size_t i = 1; i < schedule.size(); ++i)
+		{
+			double t = yearFrac(schedule[i-1], schedule[i], dayCount);
+			const double* rates = fixingRates.data() + (i - 1) * m;
+			curves.discountFactors(valueDate, schedule[i], dfs);
+			for (size_t s = 0; s < m; ++s)
+				pvs[s] += notional * rates[s] * t * dfs[s];
+		}
+
+		curves.discountFactors(valueDate, schedule.back(), dfs);
+		for (size_t s = 0; s < m; ++s)
+			pvs[s] += notional * dfs[s];
+	}
+
+	static double valueDerivative(
+		double df,
+		double dDf,
+		const year_month_day& firstAccrualDate,
+		const year_month_day& endDate,
+		EDayCount dayCount,
+		double rate,
+		double rateDerivative,
+		double notional)
+	{
+		double t = yearFrac(firstAccrualDate, endDate, dayCount);
+		return notional * t * (rateDerivative * df + rate * dDf);
+	}
+
+	// Calls f with a function from a date to the discount factor from the value date to that date, and its
+	// derivative with respect to the zero rate of the last point. The rates come from withRates, so the
+	// interpolation method is looked up once for the schedule, which is walked in order.
+	template <typename F>
+	static double withDiscountFactorDerivatives(const year_month_day& valueDate, const YieldCurve& curve, F&& f)
+	{
+		return curve.withRates([&](auto rate)
+		{
+			auto discount = [&](double t)
+			{
+				double df = exp(-rate(t) * t);
+				return std::make_pair(df, -t * curve.lastRateWeight(t) * df);
+			};
+
+			auto start = discount(curve.time(valueDate));
+			return f([&](const year_month_day& date)
+			{
+				auto end = discount(curve.time(date));
+				return std::make_pair(
+					end.first / start.first,
+					(end.second * start.first - end.first * start.second) / (start.first * start.first));
+			});
+		});
+	}
+
+	double valueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional)
+	{
+		return withDiscountFactorDerivatives(valueDate, curve, [&](auto discount)
+		{
+			double sum_dpv = 0.0;
+
+			for (
+				auto &&[firstAccrualDate, endDate]
+				: std::views::zip(schedule, schedule | std::views::drop(1)))
+			{
+				auto [df, dDf] = discount(endDate);
+				sum_dpv += valueDerivative(df, dDf, firstAccrualDate, endDate, dayCount, rate, 0.0, notional);
+			}
+
+			sum_dpv += notional * discount(schedule.back()).second;
+
+			return sum_dpv;
+		});
+	}
+
+	double valueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		const std::vector<double>& fixingRateDerivatives,
+		double notional)
+	{
+		return withDiscountFactorDerivatives(valueDate, curve, [&](auto discount)
+		{
+			double sum_dpv = 0.0;
+
+			for (
+				auto &&[firstAccrualDate, endDate, rate, rateDerivative]
+				: std::views::zip(
+					schedule,
+					schedule | std::views::drop(1),
+					fixingRates,
+					fixingRateDerivatives))
+			{
+				auto [df, dDf] = discount(endDate);
+				sum_dpv += valueDerivative(df, dDf, firstAccrualDate, endDate, dayCount, rate, rateDerivative, notional);
+			}
+
+			sum_dpv += notional * discount(schedule.back()).second;
+
+			return sum_dpv;
+		});
+	}
+
+	double forwardValueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& discountCurve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRateDerivatives,
+		double notional)
+	{
+		auto dfs = discountFactors(valueDate, discountCurve, schedule);
+
+		double sum_dpv = 0.0;
+
+		for (
+			auto &&[firstAccrualDate, endDate, df, rateDerivative]
+			: std::views::zip(
+				schedule,
+				schedule | std::views::drop(1),
+				dfs,
+				fixingRateDerivatives))
+		{
+			sum_dpv += value(df, firstAccrualDate, endDate, dayCount, rateDerivative, notional);
+		}
+
+		return sum_dpv;
+	}
+
 	static double value(
 		const year_month_day& valueDate,
 		double yield,
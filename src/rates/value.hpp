@@ -2,6 +2,7 @@
 #define __jetblack__rates__value_hpp
 
 #include <chrono>
+#include <span>
 #include <vector>
 
 #include "dates/terms.hpp"
@@ -13,6 +14,7 @@ namespace rates
 	using namespace dates;
 
 	class YieldCurve;
+	class ScenarioCurves;
 
 	double value(
 		const year_month_day& valueDate,
@@ -30,6 +32,77 @@ namespace rates
 		const std::vector<double>& fixingRates,
 		double notional);
 
+	// The values, adding their sensitivities to the zero rate of each point of the curve to deltas as
+	// the cash flows are discounted. The floating value also gives its sensitivity to each fixing rate.
+
+	double value(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional,
+		std::span<double> deltas);
+
+	double value(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		double notional,
+		std::span<double> deltas,
+		std::span<double> fixingRateDeltas);
+
+	// The values in each scenario. The fixing rates are held with the scenarios of each period together.
+
+	void values(
+		const year_month_day& valueDate,
+		const ScenarioCurves& curves,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional,
+		std::span<double> pvs);
+
+	void values(
+		const year_month_day& valueDate,
+		const ScenarioCurves& curves,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		double notional,
+		std::span<double> pvs);
+
+	// The derivatives of the curve values with respect to the zero rate of the last point of the curve.
+
+	double valueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		double rate,
+		double notional);
+
+	double valueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& curve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRates,
+		const std::vector<double>& fixingRateDerivatives,
+		double notional);
+
+	// The derivative of a floating value with respect to the zero rate of the last point of the forward
+	// curve, when the cash flows are discounted by another curve.
+	double forwardValueDerivative(
+		const year_month_day& valueDate,
+		const YieldCurve& discountCurve,
+		const std::vector<year_month_day>& schedule,
+		EDayCount dayCount,
+		const std::vector<double>& fixingRateDerivatives,
+		double notional);
+
 	double value(
 		const year_month_day& valueDate,
 		double yield,
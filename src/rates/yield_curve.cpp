@@ -1,7 +1,11 @@
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <exception>
+#include <limits>
+#include <mutex>
 #include <ranges>
+#include <thread>
 
 #include "rates/yield_curve.hpp"
 
@@ -9,6 +13,8 @@
 #include "maths/flatfwd_interp.hpp"
 #include "maths/hermite_interp.hpp"
 #include "maths/linear_interp.hpp"
+#include "maths/lu.hpp"
+#include "maths/simd.hpp"
 #include "maths/spline_interp.hpp"
 
 #include "dates/terms.hpp"
@@ -18,6 +24,31 @@ namespace rates
 	using namespace std::chrono;
 	using namespace dates;
 
+	static std::atomic<bool> recordReports {true};
+
+	void YieldCurve::recordBootstrapReports(bool record)
+	{
+		recordReports = record;
+	}
+
+	bool YieldCurve::recordsBootstrapReports()
+	{
+		return recordReports;
+	}
+
+	static std::shared_ptr<BootstrapReport> createReport()
+	{
+		return recordReports ? std::make_shared<BootstrapReport>() : nullptr;
+	}
+
+	static const std::shared_ptr<const TimeGrid>& discountTimeGrid(const std::shared_ptr<const YieldCurve>& discountCurve)
+	{
+		if (!discountCurve || !discountCurve->timeGrid())
+			throw std::invalid_argument("the discount curve must have a time grid");
+
+		return discountCurve->timeGrid();
+	}
+
 	YieldCurve::YieldCurve()
 	{
 	}
@@ -28,9 +59,10 @@ namespace rates
 		EDayCount dayCount,
 		EInterpolationMethod interpolationMethod)
 		:	valueDate_(valueDate),
-			points_(points),
+			points_(std::make_shared<std::vector<YieldCurvePoint>>(points)),
 			dayCount_(dayCount),
 			interpolationMethod_(interpolationMethod),
+			timeGrid_(TimeGrid::shared(valueDate, dayCount)),
 			interpolator_(createInterpolator(points, interpolationMethod))
 	{
 	}
@@ -51,38 +83,165 @@ namespace rates
 		const year_month_day& valueDate,
 		const std::vector<std::shared_ptr<Instrument>>& instruments,
 		EDayCount dayCount,
-		EInterpolationMethod interpolationMethod)
+		EInterpolationMethod interpolationMethod,
+		EBootstrapMethod bootstrapMethod)
 		:	valueDate_(valueDate),
-			instruments_(instruments),
+			instruments_(std::make_shared<std::vector<std::shared_ptr<Instrument>>>(instruments)),
 			dayCount_(dayCount),
-			interpolationMethod_(interpolationMethod)
+			interpolationMethod_(interpolationMethod),
+			bootstrapMethod_(bootstrapMethod),
+			timeGrid_(TimeGrid::shared(valueDate, dayCount))
 	{
 		buildCurve();
 	}
 
-	void YieldCurve::buildCurve()
+	YieldCurve::YieldCurve(
+		const std::shared_ptr<const TimeGrid>& timeGrid,
+		const std::vector<std::shared_ptr<Instrument>>& instruments,
+		EInterpolationMethod interpolationMethod,
+		EBootstrapMethod bootstrapMethod)
+		:	YieldCurve(timeGrid, nullptr, instruments, interpolationMethod, bootstrapMethod, {})
+	{
+	}
+
+	YieldCurve::YieldCurve(
+		const std::shared_ptr<const YieldCurve>& discountCurve,
+		const std::vector<std::shared_ptr<Instrument>>& instruments,
+		EInterpolationMethod interpolationMethod,
+		EBootstrapMethod bootstrapMethod)
+		:	YieldCurve(
+				discountTimeGrid(discountCurve),
+				discountCurve,
+				instruments,
+				interpolationMethod,
+				bootstrapMethod,
+				{})
+	{
+	}
+
+	YieldCurve::YieldCurve(
+		const std::shared_ptr<const TimeGrid>& timeGrid,
+		const std::shared_ptr<const YieldCurve>& discountCurve,
+		const std::vector<std::shared_ptr<Instrument>>& instruments,
+		EInterpolationMethod interpolationMethod,
+		EBootstrapMethod bootstrapMethod,
+		std::span<const double> initialRates)
+		:	valueDate_(timeGrid->valueDate()),
+			instruments_(std::make_shared<std::vector<std::shared_ptr<Instrument>>>(instruments)),
+			dayCount_(timeGrid->dayCount()),
+			interpolationMethod_(interpolationMethod),
+			bootstrapMethod_(bootstrapMethod),
+			timeGrid_(timeGrid),
+			discountCurve_(discountCurve)
 	{
-		if (instruments_.empty())
+		buildCurve(initialRates);
+	}
+
+	void YieldCurve::buildCurve(std::span<const double> initialRates)
+	{
+		if (instruments().empty())
 			throw std::length_error("instruments required for yield curve building");
 
 		// Sort the instruments into chronological order
 		std::ranges::sort(
-			instruments_,
+			mutableInstruments(),
 			[](const std::shared_ptr<Instrument>& a, const std::shared_ptr<Instrument>& b)
 			{
 				return a->maturityDate() < b->maturityDate();
 			});
 
-		solveZeroRates();
+		auto start = steady_clock::now();
+		report_ = createReport();
+
+		if (bootstrapMethod_ == EBootstrapMethod::Global)
+			solveZeroRatesGlobally(initialRates);
+		else
+			solveZeroRates(initialRates);
+
+		if (report_)
+			report_->elapsed = steady_clock::now() - start;
+	}
+
+	const maths::PiecewisePolynomial& YieldCurve::interpolationTable() const
+	{
+		if (points().empty())
+			throw std::range_error("no points in curve");
+
+		return interpolator_->get_table();
 	}
 
 	void YieldCurve::setLastRate(double z)
 	{
-		points_.back().rate(z);
-		interpolator_ = createInterpolator(
-			points_,
-			points_.size() == 1 ? EInterpolationMethod::Linear : interpolationMethod_
-		);
+		setRate(points().size() - 1, z);
+	}
+
+	void YieldCurve::setRate(size_t i, double z)
+	{
+		if (spread_)
+			throw std::logic_error("the rates of a spread view cannot be set");
+
+		mutablePoints().at(i).rate(z);
+		forwardStrip_.reset();
+
+		// The interpolator is shared between copies of the curve, so it must be cloned before it is changed.
+		if (interpolator_.use_count() > 1)
+			interpolator_ = interpolator_->clone_shared();
+
+		interpolator_->set(i, z);
+	}
+
+	std::vector<YieldCurvePoint>& YieldCurve::mutablePoints()
+	{
+		if (points_.use_count() > 1)
+			points_ = std::make_shared<std::vector<YieldCurvePoint>>(*points_);
+
+		return *points_;
+	}
+
+	std::vector<std::shared_ptr<Instrument>>& YieldCurve::mutableInstruments()
+	{
+		if (instruments_.use_count() > 1)
+			instruments_ = std::make_shared<std::vector<std::shared_ptr<Instrument>>>(*instruments_);
+
+		return *instruments_;
+	}
+
+	void YieldCurve::addPoint(const YieldCurvePoint& point)
+	{
+		mutablePoints().push_back(point);
+		forwardStrip_.reset();
+
+		auto start = steady_clock::now();
+
+		// A single point is interpolated linearly, so the interpolator is replaced when the second point arrives.
+		if (points().size() <= 2 || interpolator_.use_count() > 1)
+		{
+			interpolator_ = createInterpolator(points(), interpolationMethod_);
+
+			// Room for the points still to come, so adding them allocates nothing.
+			interpolator_->reserve(std::max(points().size(), instruments().size()));
+
+			if (report_)
+			{
+				++report_->interpolatorConstructions;
+				++report_->interpolatorAllocations;
+			}
+		}
+		else
+		{
+			auto capacity = interpolator_->capacity();
+			interpolator_->add(point.time(), point.rate());
+
+			if (report_)
+			{
+				++report_->interpolatorAdditions;
+				if (interpolator_->capacity() != capacity)
+					++report_->interpolatorAllocations;
+			}
+		}
+
+		if (report_)
+			report_->interpolatorElapsed += steady_clock::now() - start;
 	}
 
 	double YieldCurve::rate(double t) const
@@ -90,16 +249,32 @@ namespace rates
 		if (t < 0.0)
 			throw std::range_error("time is prior to value date");
 
-		if (points_.size() == 0)
+		if (points().size() == 0)
 			throw std::range_error("no points in curve");
 
-		return interpolator_->interpolate(t);
+		return addSpreads(t, interpolator_->interpolate(t));
+	}
+
+	double YieldCurve::rate(double t, maths::Interp::cursor& cursor) const
+	{
+		if (t < 0.0)
+			throw std::range_error("time is prior to value date");
+
+		if (points().size() == 0)
+			throw std::range_error("no points in curve");
+
+		return addSpreads(t, interpolator_->interpolate(t, cursor));
+	}
+
+	double YieldCurve::discountFactor(double t, maths::Interp::cursor& cursor) const
+	{
+		return maths::simd::exp(-rate(t, cursor) * t);
 	}
 
 	double YieldCurve::forwardRate(double t1, double t2) const
 	{
-		if (points_.size() == 1)
-			return points_.front().rate();
+		if (points().size() == 1 && !spread_)
+			return points().front().rate();
 
 		if (t1 == t2) return 0.0;
 
@@ -109,9 +284,10 @@ namespace rates
 		return (r2 * t2 - r1 * t1) / (t2 - t1);
 	}
 
+	// The same exponential as the batch discount factors, so they agree exactly.
 	double YieldCurve::discountFactor(double t) const
 	{
-		return exp(-rate(t) * t);
+		return maths::simd::exp(-rate(t) * t);
 	}
 
 	double YieldCurve::discountFactor(double t1, double t2) const
@@ -139,7 +315,24 @@ namespace rates
 		return discountFactor(time(d1), time(d2));
 	}
 
+	void YieldCurve::cacheFixings(size_t capacity)
+	{
+		forwardStrip_ = std::make_shared<ForwardStrip>(capacity);
+	}
+
 	double YieldCurve::fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const
+	{
+		if (!forwardStrip_)
+			return computeFix(firstAccrualDate, maturityDate, dayCount);
+
+		return forwardStrip_->fix(
+			firstAccrualDate,
+			maturityDate,
+			dayCount,
+			[&]() { return computeFix(firstAccrualDate, maturityDate, dayCount); });
+	}
+
+	double YieldCurve::computeFix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const
 	{
 		if (firstAccrualDate == maturityDate)
 			return 0.0;
@@ -151,18 +344,197 @@ namespace rates
 		return (exp(r * t) - 1.0) / period_t;
 	}
 
+	void YieldCurve::rates(std::span<const double> ts, std::span<double> rs) const
+	{
+		if (ts.size() != rs.size())
+			throw std::invalid_argument("input and output sizes differ");
+
+		if (points().size() == 0)
+			throw std::range_error("no points in curve");
+
+		for (auto t : ts)
+			if (t < 0.0)
+				throw std::range_error("time is prior to value date");
+
+		interpolator_->interpolate_batch(ts, rs);
+
+		if (spread_)
+			for (size_t i = 0; i < ts.size(); ++i)
+				rs[i] = addSpreads(ts[i], rs[i]);
+	}
+
+	void YieldCurve::rates(std::span<const year_month_day> dates, std::span<double> rs) const
+	{
+		rates(times(dates), rs);
+	}
+
+	void YieldCurve::discountFactors(std::span<const double> ts, std::span<double> dfs) const
+	{
+		rates(ts, dfs);
+
+		// Kept apart from the interpolation so the compiler can vectorise it.
+		for (size_t i = 0; i < ts.size(); ++i)
+			dfs[i] = -dfs[i] * ts[i];
+		maths::simd::exp(dfs, dfs);
+	}
+
+	void YieldCurve::discountFactors(std::span<const year_month_day> dates, std::span<double> dfs) const
+	{
+		discountFactors(times(dates), dfs);
+	}
+
+	void YieldCurve::forwardRates(std::span<const double> ts, std::span<double> fwds) const
+	{
+		if (ts.empty() || ts.size() - 1 != fwds.size())
+			throw std::invalid_argument("there must be one fewer output than input");
+
+		if (points().size() == 1 && !spread_)
+		{
+			std::ranges::fill(fwds, points().front().rate());
+			return;
+		}
+
+		std::vector<double> rs(ts.size());
+		rates(ts, rs);
+
+		for (size_t i = 0; i < fwds.size(); ++i)
+		{
+			double t1 = ts[i], t2 = ts[i+1];
+			fwds[i] = t1 == t2 ? 0.0 : (rs[i+1] * t2 - rs[i] * t1) / (t2 - t1);
+		}
+	}
+
+	void YieldCurve::forwardRates(std::span<const year_month_day> dates, std::span<double> fwds) const
+	{
+		forwardRates(times(dates), fwds);
+	}
+
+	double YieldCurve::lastRateWeight(double t) const
+	{
+		if (t < 0.0)
+			throw std::range_error("time is prior to value date");
+
+		if (points().size() == 0)
+			throw std::range_error("no points in curve");
+
+		return interpolator_->last_weight(t);
+	}
+
+	double YieldCurve::rate(double t, std::span<double> deltas, double scale) const
+	{
+		if (t < 0.0)
+			throw std::range_error("time is prior to value date");
+
+		if (points().size() == 0)
+			throw std::range_error("no points in curve");
+
+		// The spreads do not depend on the points.
+		interpolator_->add_weights(t, deltas, scale);
+		return addSpreads(t, interpolator_->interpolate(t));
+	}
+
+	double YieldCurve::discountFactor(double t, std::span<double> deltas, double scale) const
+	{
+		double df = maths::simd::exp(-rate(t) * t);
+		rate(t, deltas, -t * df * scale);
+		return df;
+	}
+
+	double YieldCurve::discountFactor(const year_month_day& date, std::span<double> deltas, double scale) const
+	{
+		return discountFactor(time(date), deltas, scale);
+	}
+
+	// The fixing rate is (df1 / df2 - 1) / period_t, and df1 / df2 is exp(r2 t2 - r1 t1).
+	double YieldCurve::fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount, std::span<double> deltas, double scale) const
+	{
+		if (firstAccrualDate == maturityDate)
+			return 0.0;
+
+		double t1 = time(firstAccrualDate);
+		double t2 = time(maturityDate);
+		double period_t = yearFrac(firstAccrualDate, maturityDate, dayCount);
+		double growth = exp(forwardRate(t1, t2) * (t2 - t1)) * scale / period_t;
+
+		rate(t2, deltas, growth * t2);
+		rate(t1, deltas, -growth * t1);
+
+		return fix(firstAccrualDate, maturityDate, dayCount);
+	}
+
+	double YieldCurve::discountFactorDerivative(double t) const
+	{
+		return -t * lastRateWeight(t) * discountFactor(t);
+	}
+
+	double YieldCurve::discountFactorDerivative(const year_month_day& date) const
+	{
+		return discountFactorDerivative(time(date));
+	}
+
+	double YieldCurve::discountFactorDerivative(const year_month_day& d1, const year_month_day& d2) const
+	{
+		double t1 = time(d1);
+		double t2 = time(d2);
+		double df1 = discountFactor(t1);
+		return (discountFactorDerivative(t2) * df1 - discountFactor(t2) * discountFactorDerivative(t1)) / (df1 * df1);
+	}
+
+	double YieldCurve::fixDerivative(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const
+	{
+		if (firstAccrualDate == maturityDate)
+			return 0.0;
+
+		double t1 = time(firstAccrualDate);
+		double t2 = time(maturityDate);
+		double r = forwardRate(t1, t2);
+		double period_t = yearFrac(firstAccrualDate, maturityDate, dayCount);
+
+		return exp(r * (t2 - t1)) * (lastRateWeight(t2) * t2 - lastRateWeight(t1) * t1) / period_t;
+	}
+
 	YieldCurve YieldCurve::shift(double x) const
 	{
-		std::vector<YieldCurvePoint> points(points_);
-		for (auto& point : points)
+		if (spread_)
+			return withoutSpread().shift(x).withSpread(*spread_);
+
+		std::vector<YieldCurvePoint> shifted(points());
+		for (auto& point : shifted)
 			point.rate(point.rate() + x);
 
-		return YieldCurve(points, valueDate_, dayCount_);
+		return YieldCurve(shifted, valueDate_, dayCount_, interpolationMethod_);
+	}
+
+	YieldCurve YieldCurve::withSpread(const ZeroRateSpread& spread) const
+	{
+		// Copying the curve copies the pointers to its state, not the state.
+		auto curve = *this;
+		if (spread_)
+			curve.base_ = std::make_shared<const YieldCurve>(*this);
+		curve.spread_ = spread;
+		// The fixings of this curve are not those of the view, and the view was not bootstrapped.
+		curve.forwardStrip_.reset();
+		curve.report_.reset();
+		return curve;
+	}
+
+	YieldCurve YieldCurve::withoutSpread() const
+	{
+		if (base_)
+			return *base_;
+
+		auto curve = *this;
+		curve.spread_.reset();
+		curve.forwardStrip_.reset();
+		return curve;
 	}
 
 	YieldCurve YieldCurve::bumpInstruments(double x) const
 	{
-        auto instruments = instruments_
+		if (spread_)
+			return withoutSpread().bumpInstruments(x).withSpread(*spread_);
+
+        auto bumped = instruments()
 			| std::views::transform(
 				[](auto&& instrument)
 				{
@@ -170,35 +542,391 @@ namespace rates
 				})
 			| std::ranges::to<std::vector<std::shared_ptr<Instrument>>>();
 
-		for (auto&& instrument : instruments)
+		for (auto&& instrument : bumped)
 		{
 			instrument->rate(instrument->rate() + x);
 		}
 
-		return YieldCurve(valueDate_, instruments, dayCount_, interpolationMethod_);
+		return YieldCurve(timeGrid_, discountCurve_, bumped, interpolationMethod_, bootstrapMethod_, {});
+	}
+
+	YieldCurve YieldCurve::rebuild(const std::vector<std::shared_ptr<Instrument>>& instruments) const
+	{
+		if (spread_)
+			return withoutSpread().rebuild(instruments).withSpread(*spread_);
+
+		auto sorted = instruments;
+		std::ranges::sort(
+			sorted,
+			[](const std::shared_ptr<Instrument>& a, const std::shared_ptr<Instrument>& b)
+			{
+				return a->maturityDate() < b->maturityDate();
+			});
+
+		// The previous rate at each new point, which is exact when the points are unchanged.
+		std::vector<double> initialRates;
+		for (const auto& instrument : sorted)
+			initialRates.push_back(rate(std::max(time(instrument->maturityDate()), 0.0)));
+
+		return YieldCurve(timeGrid_, discountCurve_, sorted, interpolationMethod_, bootstrapMethod_, initialRates);
+	}
+
+	YieldCurveUpdate YieldCurve::updateInstrumentRates(std::span<const std::pair<size_t, double>> rates) const
+	{
+		if (rates.empty())
+			return { *this, {} };
+
+		if (spread_)
+		{
+			auto update = withoutSpread().updateInstrumentRates(rates);
+			return { update.curve.withSpread(*spread_), std::move(update.changedPoints) };
+		}
+
+		auto start = steady_clock::now();
+
+		auto curve = *this;
+		curve.report_ = createReport();
+
+		size_t first = instruments().size();
+		for (const auto& [i, rate] : rates)
+		{
+			auto instrument = instruments().at(i)->clone_shared();
+			instrument->rate(rate);
+			curve.mutableInstruments()[i] = instrument;
+			first = std::min(first, i);
+		}
+
+		// The sequential bootstrap solves each point on a curve which ends at that point, so the points
+		// before the first change are unaffected. The global bootstrap solves every point again.
+		if (bootstrapMethod_ == EBootstrapMethod::Global)
+			first = 0;
+
+		std::vector<double> initialRates;
+		for (const auto& point : points())
+			initialRates.push_back(point.rate());
+
+		if (bootstrapMethod_ == EBootstrapMethod::Global)
+			curve.solveZeroRatesGlobally(initialRates);
+		else
+			curve.solveZeroRates(initialRates, first);
+
+		std::vector<size_t> changedPoints;
+		for (size_t i = first; i < points().size(); ++i)
+			if (curve.points()[i].rate() != points()[i].rate())
+				changedPoints.push_back(i);
+
+		if (curve.report_)
+			curve.report_->elapsed = steady_clock::now() - start;
+
+		return { std::move(curve), std::move(changedPoints) };
+	}
+
+	std::vector<YieldCurve> YieldCurve::bumpInstrumentLadder(double x, unsigned int threads) const
+	{
+		if (spread_)
+		{
+			auto curves = withoutSpread().bumpInstrumentLadder(x, threads);
+			for (auto& curve : curves)
+				curve = curve.withSpread(*spread_);
+			return curves;
+		}
+
+		size_t n = instruments().size();
+
+		// Each bumped curve starts from the rates of this one, as a bump moves them very little.
+		std::vector<double> initialRates;
+		for (const auto& point : points())
+			initialRates.push_back(point.rate());
+
+		std::vector<YieldCurve> curves(n);
+		std::atomic<size_t> next {0};
+		std::exception_ptr error;
+		std::mutex errorMutex;
+
+		auto build = [&]()
+		{
+			for (size_t i = next++; i < n; i = next++)
+			{
+				try
+				{
+					// Only the bumped instrument is cloned, the rest are shared and left unchanged.
+					auto bumped = instruments();
+					bumped[i] = bumped[i]->clone_shared();
+					bumped[i]->rate(bumped[i]->rate() + x);
+
+					curves[i] = YieldCurve(timeGrid_, discountCurve_, bumped, interpolationMethod_, bootstrapMethod_, initialRates);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		};
+
+		if (threads == 0)
+			threads = std::max(std::thread::hardware_concurrency(), 1u);
+		threads = static_cast<unsigned int>(std::min<size_t>(threads, n));
+
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned int i = 1; i < threads; ++i)
+				workers.emplace_back(build);
+			build();
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+
+		return curves;
+	}
+
+	std::vector<double> YieldCurve::zeroRateDeltas(const std::function<double(const YieldCurve&)>& value, double bump) const
+	{
+		// The points of a view are those of the curve without the spread.
+		if (spread_)
+			return withoutSpread().zeroRateDeltas([&](const YieldCurve& curve) { return value(curve.withSpread(*spread_)); }, bump);
+
+		auto curve = *this;
+		double pv = value(curve);
+
+		std::vector<double> deltas(points().size());
+		for (size_t j = 0; j < points().size(); ++j)
+		{
+			double z = points()[j].rate();
+			curve.setRate(j, z + bump);
+			deltas[j] = (value(curve) - pv) / bump;
+			curve.setRate(j, z);
+		}
+
+		return deltas;
+	}
+
+	/*
+	 * The bootstrap makes every instrument value V(z, q) zero, so by the implicit function theorem the
+	 * zero rates move with the instrument rates as dz/dq = -inverse(dV/dz) dV/dq. A value with zero rate
+	 * sensitivities g then has instrument rate sensitivities -transpose(dV/dq) inverse(transpose(dV/dz)) g.
+	 * Solving with the transposed jacobian once gives all of them, rather than rebuilding the curve for
+	 * each instrument. This holds when the bootstrap reprices every instrument, which is the case for
+	 * local interpolation or the global bootstrap.
+	 */
+	std::vector<double> YieldCurve::instrumentDeltas(std::span<const double> zeroRateDeltas, double bump) const
+	{
+		// The spread does not depend on the points, so the bootstrap of the curve without it maps the deltas.
+		if (spread_)
+			return withoutSpread().instrumentDeltas(zeroRateDeltas, bump);
+
+		size_t n = instruments().size();
+		if (zeroRateDeltas.size() != n || points().size() != n)
+			throw std::invalid_argument("there must be a sensitivity for each instrument");
+
+		bool isLocal = interpolationMethod_ != EInterpolationMethod::CubicSpline && interpolationMethod_ != EInterpolationMethod::Hermite;
+		if (bootstrapMethod_ == EBootstrapMethod::Sequential && !isLocal)
+			throw std::logic_error("the instrument deltas of a non-local curve need the global bootstrap");
+
+		auto curve = *this;
+
+		// Each row is the zero rate deltas of an instrument, which come with its value for a single
+		// curve. The instruments have no analytic deltas for a projection curve, so its points are bumped.
+		std::vector<double> values(n);
+		std::vector<double> jacobian(n * n, 0.0);
+		if (!discountCurve_)
+		{
+			for (size_t i = 0; i < n; ++i)
+				values[i] = instruments()[i]->value(curve, std::span(jacobian).subspan(i * n, n));
+		}
+		else
+		{
+			for (size_t i = 0; i < n; ++i)
+				values[i] = instruments()[i]->value(curve.discountCurve(), curve);
+
+			for (size_t j = 0; j < n; ++j)
+			{
+				double z = points()[j].rate();
+				curve.setRate(j, z + bump);
+				for (size_t i = 0; i < n; ++i)
+					jacobian[i * n + j] = (instruments()[i]->value(curve.discountCurve(), curve) - values[i]) / bump;
+				curve.setRate(j, z);
+			}
+		}
+
+		std::vector<size_t> pivots;
+		maths::lu::decompose(jacobian, n, pivots);
+
+		std::vector<double> adjoints(zeroRateDeltas.begin(), zeroRateDeltas.end());
+		maths::lu::solve_transpose(jacobian, n, pivots, adjoints);
+
+		std::vector<double> deltas(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			auto instrument = instruments()[i]->clone_shared();
+			instrument->rate(instrument->rate() + bump);
+			double dVdq = (instrument->bootstrapValue(curve) - values[i]) / bump;
+			deltas[i] = -adjoints[i] * dVdq;
+		}
+
+		return deltas;
 	}
 
 	double YieldCurve::time(const year_month_day& date) const
 	{
-		return yearFrac(valueDate_, date, dayCount_);
+		// A default constructed curve has no grid.
+		if (!timeGrid_)
+			return yearFrac(valueDate_, date, dayCount_);
+
+		return timeGrid_->time(date);
+	}
+
+	std::vector<double> YieldCurve::times(std::span<const year_month_day> dates) const
+	{
+		if (timeGrid_)
+			return timeGrid_->times(dates);
+
+		std::vector<double> ts;
+		ts.reserve(dates.size());
+		for (const auto& date : dates)
+			ts.push_back(time(date));
+		return ts;
 	}
 
 	// Solver method - stick in a point for the end point of each instrument, and then solve for the zero rate at that point
 	// which gives us a zero value for the instrument.
-	void YieldCurve::solveZeroRates()
+	void YieldCurve::solveZeroRates(std::span<const double> initialRates, size_t first)
 	{
-		points_.clear();
+		// The points before the first are kept.
+		mutablePoints().resize(first);
+		forwardStrip_.reset();
+		if (first == 0)
+			interpolator_.reset();
+		else
+		{
+			interpolator_ = createInterpolator(points(), interpolationMethod_);
+			if (report_)
+			{
+				++report_->interpolatorConstructions;
+				++report_->interpolatorAllocations;
+			}
+		}
 
-		double r = 0.05;
+		double r = first == 0 ? 0.05 : points().back().rate();
 
-		for (auto&& instrument : instruments_)
+		for (auto i = first; i < instruments().size(); ++i)
 		{
+			const auto& instrument = instruments()[i];
+			auto start = steady_clock::now();
+			InstrumentSolveReport report;
+
 			auto t = time(instrument->maturityDate());
-			points_.push_back({t, r});
-			r = instrument->solveZeroRate(*this);
+			// Start from the given rate when there is one, otherwise from the previous solution.
+			bool solved = false;
+			if (i < initialRates.size())
+			{
+				addPoint({t, initialRates[i]});
+				try
+				{
+					r = instrument->solveZeroRate(
+						*this,
+						100,
+						std::numeric_limits<double>::epsilon(),
+						std::max(initialRates[i] - InitialRateBracket, minZeroRate()),
+						initialRates[i] + InitialRateBracket,
+						report_ ? &report : nullptr);
+					solved = true;
+				}
+				catch (const std::range_error&)
+				{
+					// The rate has moved further than expected, so search the full range.
+					setLastRate(initialRates[i]);
+					report.widenedBracket = true;
+				}
+			}
+			else
+			{
+				addPoint({t, r});
+			}
+
+			if (!solved)
+				r = instrument->solveZeroRate(*this, 100, std::numeric_limits<double>::epsilon(), minZeroRate(), MaxZeroRate, report_ ? &report : nullptr);
+
+			if (report_)
+			{
+				report.elapsed = steady_clock::now() - start;
+				report_->instruments.push_back(report);
+			}
 		}
 	}
 
+	// Newton's method over all the zero rates, starting from the sequential solution. The jacobian is
+	// found by bumping each point and is reused while the residuals keep falling quickly.
+	void YieldCurve::solveZeroRatesGlobally(std::span<const double> initialRates, unsigned int maxIterations, double errorTolerance)
+	{
+		solveZeroRates(initialRates);
+
+		const double bump = 1e-7;
+
+		size_t n = instruments().size();
+		std::vector<double> residuals(n), bumped(n), jacobian(n * n);
+		std::vector<size_t> pivots;
+
+		auto reprice = [&](std::vector<double>& values)
+		{
+			for (size_t i = 0; i < n; ++i)
+				values[i] = instruments()[i]->bootstrapValue(*this);
+			if (report_)
+				report_->globalEvaluations += static_cast<unsigned int>(n);
+		};
+
+		double lastNorm = std::numeric_limits<double>::infinity();
+		bool factorised = false;
+
+		for (unsigned int iteration = 0; iteration < maxIterations; ++iteration)
+		{
+			reprice(residuals);
+
+			double norm = 0.0;
+			for (auto residual : residuals)
+				norm = std::max(norm, fabs(residual));
+
+			if (norm == 0.0)
+				return;
+
+			if (!factorised || norm > 0.5 * lastNorm)
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					double z = points()[j].rate();
+					setRate(j, z + bump);
+					reprice(bumped);
+					setRate(j, z);
+
+					for (size_t i = 0; i < n; ++i)
+						jacobian[i * n + j] = (bumped[i] - residuals[i]) / bump;
+				}
+
+				maths::lu::decompose(jacobian, n, pivots);
+				factorised = true;
+			}
+			lastNorm = norm;
+
+			maths::lu::solve(jacobian, n, pivots, residuals);
+			if (report_)
+				++report_->globalIterations;
+
+			double step = 0.0;
+			for (size_t j = 0; j < n; ++j)
+			{
+				setRate(j, std::max(points()[j].rate() - residuals[j], minZeroRate()));
+				step = std::max(step, fabs(residuals[j]));
+			}
+
+			if (step <= errorTolerance)
+				return;
+		}
+
+		throw std::range_error("Failed to find root");
+	}
+
 	std::shared_ptr<maths::Interp> YieldCurve::createInterpolator(const std::vector<YieldCurvePoint>& points, EInterpolationMethod interpolationMethod)
 	{
 		std::vector<double> x, y;
@@ -2,15 +2,24 @@
 #define __jetblack__rates__yield_curve_hpp
 
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "dates/terms.hpp"
 #include "maths/interp.hpp"
 
+#include "rates/bootstrap_report.hpp"
+#include "rates/forward_strip.hpp"
 #include "rates/instrument.hpp"
+#include "rates/time_grid.hpp"
 #include "rates/yield_curve_point.hpp"
+#include "rates/zero_rate_spread.hpp"
 
 namespace rates
 {
@@ -23,18 +32,38 @@ namespace rates
 		CubicSpline,
 		FlatForward,
 		Hermite,
-		Exponential
+		Exponential // the zero rates must be positive
 	};
 
+	/*
+	 * Sequential bootstrapping solves each point in turn, which reprices every instrument when the
+	 * interpolation is local. With non-local interpolation (cubic spline, Hermite) later points move
+	 * the rates before them, so the global method solves for all the points simultaneously.
+	 */
+	enum class EBootstrapMethod
+	{
+		Sequential,
+		Global
+	};
+
+	struct YieldCurveUpdate;
+
 	class YieldCurve
 	{
 	private:
 		year_month_day					valueDate_;
-		std::vector<std::shared_ptr<Instrument>>	instruments_;
-		std::vector<YieldCurvePoint>	points_;
+		std::shared_ptr<std::vector<std::shared_ptr<Instrument>>>	instruments_ {std::make_shared<std::vector<std::shared_ptr<Instrument>>>()};
+		std::shared_ptr<std::vector<YieldCurvePoint>>	points_ {std::make_shared<std::vector<YieldCurvePoint>>()};
 		EDayCount						dayCount_;
 		EInterpolationMethod			interpolationMethod_;
+		EBootstrapMethod				bootstrapMethod_ {EBootstrapMethod::Sequential};
+		std::shared_ptr<const TimeGrid>	timeGrid_;
+		std::shared_ptr<const YieldCurve>	discountCurve_;
 		std::shared_ptr<maths::Interp>	interpolator_;
+		std::shared_ptr<BootstrapReport>	report_;
+		std::shared_ptr<ForwardStrip>	forwardStrip_;
+		std::shared_ptr<const YieldCurve>	base_;
+		std::optional<ZeroRateSpread>	spread_;
 
 	public:
 		YieldCurve();
@@ -54,19 +83,100 @@ namespace rates
 			const year_month_day& valueDate,
 			const std::vector<std::shared_ptr<Instrument>>& instruments,
 			EDayCount dayCount,
-			EInterpolationMethod interpolationMethod);
+			EInterpolationMethod interpolationMethod,
+			EBootstrapMethod bootstrapMethod = EBootstrapMethod::Sequential);
+
+		// Bootstrap on an existing time grid, which gives the value date and day count.
+		YieldCurve(
+			const std::shared_ptr<const TimeGrid>& timeGrid,
+			const std::vector<std::shared_ptr<Instrument>>& instruments,
+			EInterpolationMethod interpolationMethod,
+			EBootstrapMethod bootstrapMethod = EBootstrapMethod::Sequential);
+
+		// Bootstrap a projection curve for instruments discounted by a curve which has already been built.
+		// The curves share the time grid.
+		YieldCurve(
+			const std::shared_ptr<const YieldCurve>& discountCurve,
+			const std::vector<std::shared_ptr<Instrument>>& instruments,
+			EInterpolationMethod interpolationMethod,
+			EBootstrapMethod bootstrapMethod = EBootstrapMethod::Sequential);
 
 		const year_month_day& valueDate() const { return valueDate_; }
 		// std::vector<YieldCurvePoint>& points() { return points_; }
-		const std::vector<YieldCurvePoint>& points() const { return points_; }
+		const std::vector<YieldCurvePoint>& points() const { return *points_; }
+		// The instruments in maturity order, which is the order of the points.
+		const std::vector<std::shared_ptr<Instrument>>& instruments() const { return *instruments_; }
 		EDayCount dayCount() const { return dayCount_; }
+		EInterpolationMethod interpolationMethod() const { return interpolationMethod_; }
+		EBootstrapMethod bootstrapMethod() const { return bootstrapMethod_; }
+		// The conversion of dates to times, which callers can use to resolve their dates once.
+		const std::shared_ptr<const TimeGrid>& timeGrid() const { return timeGrid_; }
+		// The compiled interpolation of the zero rates, without the spread of a view.
+		const maths::PiecewisePolynomial& interpolationTable() const;
+		// What happened while the points were solved, or null if the curve was not bootstrapped or
+		// reports were not being recorded.
+		std::shared_ptr<const BootstrapReport> bootstrapReport() const { return report_; }
+		// Whether bootstrapping records a report, which it does by default. The setting applies to
+		// every curve built after it is changed.
+		static void recordBootstrapReports(bool record);
+		static bool recordsBootstrapReports();
+		// The curve the instruments are discounted with, which is this curve unless it is a projection curve.
+		const YieldCurve& discountCurve() const { return discountCurve_ ? *discountCurve_ : *this; }
+		// Whether the instruments are discounted by another curve, rather than priced on this one alone.
+		bool isProjectionCurve() const { return discountCurve_ != nullptr; }
 
 		YieldCurve shift(double) const;
+		/*
+		 * A view of this curve with the spread added to its zero rates. The view shares the points,
+		 * instruments and interpolator of this curve, so nothing is copied, solved or fitted, and it
+		 * stays valid when this curve goes. Stacking a view on a view keeps the one below in a single
+		 * allocation. Shifting, bumping, rebuilding and the deltas work on the curve without the spread
+		 * and add it back, setting a rate throws, and a view cannot be compiled or written to a snapshot.
+		 */
+		YieldCurve withSpread(const ZeroRateSpread& spread) const;
+		bool isSpreadView() const { return spread_.has_value(); }
 		YieldCurve bumpInstruments(double) const;
+		// A curve built from new instruments, starting from the rates of this curve.
+		YieldCurve rebuild(const std::vector<std::shared_ptr<Instrument>>& instruments) const;
+		// A curve with new rates for some of the instruments, given by their index in instruments().
+		YieldCurveUpdate updateInstrumentRates(std::span<const std::pair<size_t, double>> rates) const;
+		// A curve for each instrument with only that instrument's rate bumped, built concurrently.
+		std::vector<YieldCurve> bumpInstrumentLadder(double x, unsigned int threads = 0) const;
 
 		double rate(double t) const;
 		double rate(const year_month_day& date) const;
+		// Lookups with a cursor held by the caller, for times which mostly increase such as along a schedule.
+		double rate(double t, maths::Interp::cursor& cursor) const;
+		double discountFactor(double t, maths::Interp::cursor& cursor) const;
+
+		/*
+		 * Calls f with a function from time to zero rate in which the interpolation method is fixed at
+		 * compile time, so the lookups inline into the loop in f. The method is looked up once, and the
+		 * function starts each lookup from the last, so increasing times are cheapest. The function
+		 * gives the same rates as rate(t), and refers to this curve, so must not outlive it.
+		 */
+		template <typename F>
+		decltype(auto) withRates(F&& f) const
+		{
+			if (points_->empty())
+				throw std::range_error("no points in curve");
+
+			const auto& table = interpolator_->get_table();
+			return table.dispatch([&](auto transform) -> decltype(auto)
+			{
+				size_t segment = 0;
+				return f([this, &table, segment](double t) mutable
+				{
+					if (t < 0.0)
+						throw std::range_error("time is prior to value date");
+
+					return addSpreads(t, table.template evaluate<decltype(transform)::value>(t, segment));
+				});
+			});
+		}
+
 		void setLastRate(double z);
+		void setRate(size_t i, double z);
 
 		double forwardRate(double t1, double t2) const;
 		double forwardRate(const year_month_day& firstAccrualDate, const year_month_day& endDate) const;
@@ -78,16 +188,104 @@ namespace rates
 
 		double fix(const year_month_day& valueDate, const year_month_day& fixingDate, EDayCount dayCount) const;
 
+		// Keep the fixing rates in a strip shared by the copies of this curve, so the floating legs priced
+		// against it compute each fixing period once. Changing a rate of the curve drops the strip.
+		void cacheFixings(size_t capacity = ForwardStrip::DefaultCapacity);
+		std::shared_ptr<const ForwardStrip> forwardStrip() const { return forwardStrip_; }
+
+		// Batch versions of the above, which fill the output span. The forward rates are for the
+		// consecutive periods of the input, so there is one fewer output than input.
+		void rates(std::span<const double> ts, std::span<double> rs) const;
+		void rates(std::span<const year_month_day> dates, std::span<double> rs) const;
+		void discountFactors(std::span<const double> ts, std::span<double> dfs) const;
+		void discountFactors(std::span<const year_month_day> dates, std::span<double> dfs) const;
+		void forwardRates(std::span<const double> ts, std::span<double> fwds) const;
+		void forwardRates(std::span<const year_month_day> dates, std::span<double> fwds) const;
+
+		// Derivatives with respect to the zero rate of the last point, as used when bootstrapping.
+		double lastRateWeight(double t) const;
+		double discountFactorDerivative(double t) const;
+		double discountFactorDerivative(const year_month_day& date) const;
+		double discountFactorDerivative(const year_month_day& firstAccrualDate, const year_month_day& endDate) const;
+		double fixDerivative(const year_month_day& valueDate, const year_month_day& fixingDate, EDayCount dayCount) const;
+
+		/*
+		 * The rate, discount factor and fixing rate, adding scale times their sensitivities to the zero
+		 * rate of each point to deltas, which has an entry for each point of the curve, or of the
+		 * curve a view refers to. A value summed from these gets the same deltas as zeroRateDeltas in
+		 * the same pass, from the weights of the interpolator rather than by bumping the points.
+		 */
+		double rate(double t, std::span<double> deltas, double scale = 1.0) const;
+		double discountFactor(double t, std::span<double> deltas, double scale = 1.0) const;
+		double discountFactor(const year_month_day& date, std::span<double> deltas, double scale = 1.0) const;
+		double fix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount, std::span<double> deltas, double scale = 1.0) const;
+
+		// The sensitivity of a value to the zero rate of each point, found by bumping the points of a copy of the curve.
+		std::vector<double> zeroRateDeltas(const std::function<double(const YieldCurve&)>& value, double bump = 1e-7) const;
+		/*
+		 * Maps sensitivities to the zero rates to sensitivities to the instrument rates with one adjoint
+		 * solve. This relies on the bootstrap repricing every instrument, which a sequential bootstrap
+		 * only does with local interpolation, so with cubic spline or Hermite interpolation the curve
+		 * must be built with the global bootstrap, and a logic_error is thrown otherwise. The bump is
+		 * used for the sensitivities of the values to the instrument rates, and to the points of a
+		 * projection curve.
+		 */
+		std::vector<double> instrumentDeltas(std::span<const double> zeroRateDeltas, double bump = 1e-7) const;
+
 		double time(const year_month_day& date) const;
+		std::vector<double> times(std::span<const year_month_day> dates) const;
 
 	private:
-		void buildCurve();
-		void solveZeroRates();
+		// When a point has an initial rate, the root is first sought within this distance of it.
+		static constexpr double InitialRateBracket = 0.01;
+		// The range searched for a zero rate. Exponential interpolation needs positive rates, so the
+		// search stays above zero for it.
+		static constexpr double MinZeroRate = -0.1;
+		static constexpr double MinPositiveZeroRate = 1e-8;
+		static constexpr double MaxZeroRate = 1.0;
+
+		double minZeroRate() const { return interpolationMethod_ == EInterpolationMethod::Exponential ? MinPositiveZeroRate : MinZeroRate; }
+
+		YieldCurve(
+			const std::shared_ptr<const TimeGrid>& timeGrid,
+			const std::shared_ptr<const YieldCurve>& discountCurve,
+			const std::vector<std::shared_ptr<Instrument>>& instruments,
+			EInterpolationMethod interpolationMethod,
+			EBootstrapMethod bootstrapMethod,
+			std::span<const double> initialRates);
+
+		void buildCurve(std::span<const double> initialRates = {});
+		void solveZeroRates(std::span<const double> initialRates = {}, size_t first = 0);
+		void solveZeroRatesGlobally(
+			std::span<const double> initialRates = {},
+			unsigned int maxIterations = 50,
+			double errorTolerance = 1e-12);
+		void addPoint(const YieldCurvePoint& point);
+		// The points and instruments are shared between copies of the curve, so they are copied before they are changed.
+		std::vector<YieldCurvePoint>& mutablePoints();
+		std::vector<std::shared_ptr<Instrument>>& mutableInstruments();
+		double computeFix(const year_month_day& firstAccrualDate, const year_month_day& maturityDate, EDayCount dayCount) const;
+
+		// The curve a view adds its spread to, which shares the points and interpolator of this one.
+		YieldCurve withoutSpread() const;
+		// Add the spreads of the views from the bottom of the stack up to this one.
+		double addSpreads(double t, double r) const { return spread_ ? (base_ ? base_->addSpreads(t, r) : r) + (*spread_)(t) : r; }
 		
 		static std::shared_ptr<maths::Interp> createInterpolator(
 			const std::vector<YieldCurvePoint>& points,
 			EInterpolationMethod interpolationMethod);
 	};
+
+	/*
+	 * The result of updating the instrument rates of a curve, with the indices of the points whose
+	 * rates have changed, so dependent caches can be invalidated selectively. Note that with non-local
+	 * interpolation (cubic spline, Hermite) the rates between unchanged points may still move.
+	 */
+	struct YieldCurveUpdate
+	{
+		YieldCurve			curve;
+		std::vector<size_t>	changedPoints;
+	};
 }
 
 extern rates::EInterpolationMethod& operator>>(const std::string& lhs, rates::EInterpolationMethod& rhs);
@@ -0,0 +1,112 @@
+#ifndef __jetblack__rates__yield_curve_handle_hpp
+#define __jetblack__rates__yield_curve_handle_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "rates/yield_curve.hpp"
+
+namespace rates
+{
+	/*
+	 * Publishes rebuilt curves to pricing threads.
+	 *
+	 * A writer builds a new curve away from the handle and then publishes it, which swaps the pointer
+	 * and advances the version. Each pricing thread holds a Reader, which keeps its own reference to
+	 * the curve it last saw. Getting the curve from a reader is a single atomic load of the version,
+	 * so readers never take a lock or touch the reference count unless a new curve has been published.
+	 * A superseded curve is freed when the last reader holding it moves on.
+	 */
+
+	class YieldCurveHandle
+	{
+	private:
+		alignas(64) std::atomic<std::uint64_t>	version_ {0};
+		mutable std::mutex						mutex_;
+		std::shared_ptr<const YieldCurve>		curve_;
+
+	public:
+		class Reader
+		{
+		private:
+			const YieldCurveHandle*				handle_;
+			std::uint64_t						version_;
+			std::shared_ptr<const YieldCurve>	curve_;
+
+		public:
+			explicit Reader(const YieldCurveHandle& handle)
+				:	handle_(&handle)
+			{
+				refresh();
+			}
+
+			/*
+			 * The latest curve. The reference is only valid until the next call on this reader: a call
+			 * which finds a new curve published drops the reader's reference to the old one, which is
+			 * freed if nothing else holds it. Use sharedCurve to keep a curve across calls.
+			 */
+			const YieldCurve& curve()
+			{
+				return *sharedCurve();
+			}
+
+			// The latest curve, as the reader's own pointer, which can be copied to keep the curve alive.
+			const std::shared_ptr<const YieldCurve>& sharedCurve()
+			{
+				if (handle_->version_.load(std::memory_order_acquire) != version_)
+					refresh();
+
+				return curve_;
+			}
+
+			// These have the same lifetime as curve().
+			const YieldCurve& operator*() { return curve(); }
+			const YieldCurve* operator->() { return &curve(); }
+
+			std::uint64_t version() const { return version_; }
+
+		private:
+			void refresh()
+			{
+				std::lock_guard<std::mutex> lock(handle_->mutex_);
+				version_ = handle_->version_.load(std::memory_order_relaxed);
+				curve_ = handle_->curve_;
+			}
+		};
+
+		explicit YieldCurveHandle(std::shared_ptr<const YieldCurve> curve)
+		{
+			publish(std::move(curve));
+		}
+
+		YieldCurveHandle(const YieldCurveHandle&) = delete;
+		YieldCurveHandle& operator=(const YieldCurveHandle&) = delete;
+
+		void publish(std::shared_ptr<const YieldCurve> curve)
+		{
+			if (!curve)
+				throw std::invalid_argument("a curve is required");
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			// Swap rather than assign, so the old curve is released outside the lock.
+			curve_.swap(curve);
+			version_.fetch_add(1, std::memory_order_release);
+		}
+
+		// A reference to the current curve for occasional use. Pricing threads should hold a Reader.
+		std::shared_ptr<const YieldCurve> curve() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return curve_;
+		}
+
+		std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+		Reader reader() const { return Reader(*this); }
+	};
+}
+
+#endif // __jetblack__rates__yield_curve_handle_hpp
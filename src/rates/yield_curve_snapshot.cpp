@@ -0,0 +1,202 @@
+#include "rates/yield_curve_snapshot.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	static_assert(sizeof(YieldCurveSnapshot::Header) % sizeof(double) == 0, "the arrays must be aligned");
+
+	YieldCurveSnapshot::YieldCurveSnapshot(const std::string& path)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd == -1)
+			throw std::runtime_error("unable to open snapshot: " + path);
+
+		struct stat st;
+		if (::fstat(fd, &st) == -1)
+		{
+			::close(fd);
+			throw std::runtime_error("unable to read snapshot: " + path);
+		}
+
+		size_ = static_cast<std::size_t>(st.st_size);
+		mapping_ = size_ < sizeof(Header) ? MAP_FAILED : ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+
+		if (mapping_ == MAP_FAILED)
+		{
+			mapping_ = nullptr;
+			throw std::runtime_error("unable to map snapshot: " + path);
+		}
+
+		header_ = static_cast<const Header*>(mapping_);
+
+		if (header_->magic != Magic || header_->version != Version)
+		{
+			unmap();
+			throw std::runtime_error("not a supported snapshot: " + path);
+		}
+
+		// The counts are bounded by the file before they are multiplied, so the size check cannot overflow.
+		std::uint64_t n = header_->pointCount;
+		std::uint64_t m = header_->regionCount;
+		std::uint64_t capacity = (size_ - sizeof(Header)) / sizeof(double);
+		if (n == 0 || n > capacity || m > capacity
+			|| size_ != sizeof(Header) + sizeof(double) * (2 * n + m * (1 + CompiledYieldCurve::Order)))
+		{
+			unmap();
+			throw std::runtime_error("corrupt snapshot: " + path);
+		}
+
+		// The compiled kernel reads a region for each segment and either end, and the
+		// enums are cast from the header, so these are checked before anything is read.
+		auto data = reinterpret_cast<const double*>(static_cast<const char*>(mapping_) + sizeof(Header));
+		bool valid = m == n + 1
+			&& header_->form <= static_cast<std::uint32_t>(CompiledYieldCurve::EForm::LogRate)
+			&& header_->dayCount <= static_cast<std::uint32_t>(EDayCount::Actual_Actual_AFB)
+			&& header_->interpolationMethod <= static_cast<std::uint32_t>(EInterpolationMethod::Exponential);
+		for (std::uint64_t i = 0; valid && i < n; ++i)
+			valid = std::isfinite(data[i]) && (i == 0 || data[i-1] < data[i]);
+
+		if (!valid)
+		{
+			unmap();
+			throw std::runtime_error("corrupt snapshot: " + path);
+		}
+
+		times_ = { data, n };
+		rates_ = { data + n, n };
+		origins_ = data + 2 * n;
+		for (std::size_t i = 0; i < CompiledYieldCurve::Order; ++i)
+			coefficients_[i] = origins_ + (i + 1) * m;
+
+		timeGrid_ = TimeGrid::shared(valueDate(), dayCount());
+	}
+
+	YieldCurveSnapshot::~YieldCurveSnapshot()
+	{
+		unmap();
+	}
+
+	YieldCurveSnapshot::YieldCurveSnapshot(YieldCurveSnapshot&& rhs) noexcept
+		:	mapping_(std::exchange(rhs.mapping_, nullptr)),
+			size_(std::exchange(rhs.size_, 0)),
+			header_(std::exchange(rhs.header_, nullptr)),
+			times_(rhs.times_),
+			rates_(rhs.rates_),
+			origins_(std::exchange(rhs.origins_, nullptr)),
+			coefficients_(rhs.coefficients_),
+			timeGrid_(std::move(rhs.timeGrid_))
+	{
+	}
+
+	YieldCurveSnapshot& YieldCurveSnapshot::operator=(YieldCurveSnapshot&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			unmap();
+			mapping_ = std::exchange(rhs.mapping_, nullptr);
+			size_ = std::exchange(rhs.size_, 0);
+			header_ = std::exchange(rhs.header_, nullptr);
+			times_ = rhs.times_;
+			rates_ = rhs.rates_;
+			origins_ = std::exchange(rhs.origins_, nullptr);
+			coefficients_ = rhs.coefficients_;
+			timeGrid_ = std::move(rhs.timeGrid_);
+		}
+		return *this;
+	}
+
+	void YieldCurveSnapshot::unmap()
+	{
+		if (mapping_ != nullptr)
+			::munmap(mapping_, size_);
+
+		mapping_ = nullptr;
+		header_ = nullptr;
+	}
+
+	void YieldCurveSnapshot::write(const YieldCurve& curve, const std::string& path)
+	{
+		if (curve.isSpreadView())
+			throw std::invalid_argument("a spread view cannot be written to a snapshot");
+
+		const auto& points = curve.points();
+		if (points.empty())
+			throw std::range_error("no points in curve");
+
+		std::vector<double> data;
+		for (const auto& point : points)
+			data.push_back(point.time());
+		for (const auto& point : points)
+			data.push_back(point.rate());
+
+		auto compiled = CompiledYieldCurve{curve};
+		data.insert(data.end(), compiled.origins().begin(), compiled.origins().end());
+		for (std::size_t i = 0; i < CompiledYieldCurve::Order; ++i)
+			data.insert(data.end(), compiled.coefficients(i).begin(), compiled.coefficients(i).end());
+
+		Header header {};
+		header.magic = Magic;
+		header.version = Version;
+		header.dayCount = static_cast<std::uint32_t>(curve.dayCount());
+		header.interpolationMethod = static_cast<std::uint32_t>(curve.interpolationMethod());
+		header.form = static_cast<std::uint32_t>(compiled.form());
+		header.valueDate = sys_days{curve.valueDate()}.time_since_epoch().count();
+		header.pointCount = points.size();
+		header.regionCount = compiled.origins().size();
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(double)));
+		if (!file)
+			throw std::runtime_error("unable to write snapshot: " + path);
+	}
+
+	double YieldCurveSnapshot::logDiscountFactor(double t) const
+	{
+		return CompiledYieldCurve::logDiscountFactor(static_cast<CompiledYieldCurve::EForm>(header_->form), times_, origins_, coefficients_, t);
+	}
+
+	double YieldCurveSnapshot::rate(double t) const
+	{
+		if (t < 0.0)
+			throw std::range_error("time is prior to value date");
+
+		// To the left of the first point the rate is flat, which avoids dividing by a zero time.
+		if (t <= times_.front())
+			return rates_.front();
+
+		return logDiscountFactor(t) / t;
+	}
+
+	double YieldCurveSnapshot::discountFactor(double t) const
+	{
+		if (t < 0.0)
+			throw std::range_error("time is prior to value date");
+
+		return std::exp(-logDiscountFactor(t));
+	}
+
+	YieldCurve YieldCurveSnapshot::curve() const
+	{
+		std::vector<YieldCurvePoint> points;
+		for (std::size_t i = 0; i < times_.size(); ++i)
+			points.push_back({times_[i], rates_[i]});
+
+		return YieldCurve(points, valueDate(), dayCount(), interpolationMethod());
+	}
+}
@@ -0,0 +1,94 @@
+#ifndef __jetblack__rates__yield_curve_snapshot_hpp
+#define __jetblack__rates__yield_curve_snapshot_hpp
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "dates/terms.hpp"
+
+#include "rates/compiled_yield_curve.hpp"
+#include "rates/time_grid.hpp"
+#include "rates/yield_curve.hpp"
+
+namespace rates
+{
+	using namespace std::chrono;
+	using namespace dates;
+
+	/*
+	 * A built yield curve saved in a binary file which is mapped into memory to be read.
+	 *
+	 * The file is a fixed size header followed by arrays of doubles in native byte order: the point
+	 * times, the point rates, and the origins and coefficients of the compiled curve (see
+	 * CompiledYieldCurve). Loading validates the header and sizes and then reads the arrays in place,
+	 * so there is no parsing, and the only allocation is the time grid, which is shared with the curves
+	 * of the same value date and day count. The rates and discount factors are evaluated directly from
+	 * the mapping, and curve() rebuilds a YieldCurve.
+	 */
+
+	class YieldCurveSnapshot
+	{
+	public:
+		static constexpr std::array<char, 8> Magic { 'J', 'B', 'Y', 'C', 'S', 'N', 'A', 'P' };
+		static constexpr std::uint32_t Version = 2;
+
+		struct Header
+		{
+			std::array<char, 8>	magic;
+			std::uint32_t		version;
+			std::uint32_t		dayCount;
+			std::uint32_t		interpolationMethod;
+			std::uint32_t		form; // the CompiledYieldCurve::EForm of the compiled tables
+			std::int64_t		valueDate; // days since the epoch
+			std::uint64_t		pointCount;
+			std::uint64_t		regionCount; // one more than the point count
+		};
+
+	private:
+		void*									mapping_ {nullptr};
+		std::size_t								size_ {0};
+		const Header*							header_ {nullptr};
+		std::span<const double>					times_ {};
+		std::span<const double>					rates_ {};
+		const double*							origins_ {nullptr};
+		std::array<const double*, CompiledYieldCurve::Order>	coefficients_ {};
+		std::shared_ptr<const TimeGrid>			timeGrid_ {};
+
+	public:
+		explicit YieldCurveSnapshot(const std::string& path);
+		~YieldCurveSnapshot();
+
+		YieldCurveSnapshot(const YieldCurveSnapshot&) = delete;
+		YieldCurveSnapshot& operator=(const YieldCurveSnapshot&) = delete;
+		YieldCurveSnapshot(YieldCurveSnapshot&& rhs) noexcept;
+		YieldCurveSnapshot& operator=(YieldCurveSnapshot&& rhs) noexcept;
+
+		static void write(const YieldCurve& curve, const std::string& path);
+
+		year_month_day valueDate() const { return year_month_day{sys_days{days{header_->valueDate}}}; }
+		EDayCount dayCount() const { return static_cast<EDayCount>(header_->dayCount); }
+		EInterpolationMethod interpolationMethod() const { return static_cast<EInterpolationMethod>(header_->interpolationMethod); }
+		std::span<const double> times() const { return times_; }
+		std::span<const double> rates() const { return rates_; }
+
+		double rate(double t) const;
+		double discountFactor(double t) const;
+		double discountFactor(const year_month_day& date) const { return discountFactor(time(date)); }
+		const std::shared_ptr<const TimeGrid>& timeGrid() const { return timeGrid_; }
+		double time(const year_month_day& date) const { return timeGrid_->time(date); }
+
+		// The full curve, rebuilt from the points.
+		YieldCurve curve() const;
+
+	private:
+		double logDiscountFactor(double t) const;
+		void unmap();
+	};
+}
+
+#endif // __jetblack__rates__yield_curve_snapshot_hpp
@@ -0,0 +1,62 @@
+#ifndef __jetblack__rates__zero_rate_spread_hpp
+#define __jetblack__rates__zero_rate_spread_hpp
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+
+namespace rates
+{
+	/*
+	 * A spread added to the zero rates of a curve. It is either constant, or linear between the given
+	 * times and flat outside them. A piecewise spread refers to the caller's times and spreads rather
+	 * than copying them, so they must outlive it.
+	 */
+
+	class ZeroRateSpread
+	{
+	private:
+		double constant_ {0};
+		std::span<const double> times_ {};
+		std::span<const double> spreads_ {};
+
+	public:
+		ZeroRateSpread() = default;
+
+		ZeroRateSpread(double spread)
+			:	constant_(spread)
+		{
+		}
+
+		ZeroRateSpread(std::span<const double> times, std::span<const double> spreads)
+			:	times_(times),
+				spreads_(spreads)
+		{
+			if (times.empty() || times.size() != spreads.size())
+				throw std::invalid_argument("there must be a spread for each time");
+
+			if (!std::ranges::is_sorted(times))
+				throw std::invalid_argument("the times must be in order");
+		}
+
+		double operator()(double t) const
+		{
+			if (times_.empty())
+				return constant_;
+
+			if (t <= times_.front())
+				return spreads_.front();
+			if (t >= times_.back())
+				return spreads_.back();
+
+			size_t i = std::distance(times_.begin(), std::ranges::upper_bound(times_, t));
+			double w = (t - times_[i-1]) / (times_[i] - times_[i-1]);
+			return spreads_[i-1] + w * (spreads_[i] - spreads_[i-1]);
+		}
+
+		bool isConstant() const { return times_.empty(); }
+	};
+}
+
+#endif // __jetblack__rates__zero_rate_spread_hpp
@@ -0,0 +1,297 @@
+#include "maths/exp_interp.hpp"
+#include "maths/flatfwd_interp.hpp"
+#include "maths/hermite_interp.hpp"
+#include "maths/linear_interp.hpp"
+#include "maths/spline_interp.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace maths;
+
+// Counted, to check the spline is built in place.
+static size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static const std::vector<double> xa { 0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0 };
+static const std::vector<double> ya { 0.031, 0.033, 0.034, 0.037, 0.038, 0.041, 0.042, 0.044 };
+
+// Points before, between, at and after the knots.
+static std::vector<double> samples()
+{
+    std::vector<double> xs { 0.1, 12.0 };
+    for (double x : xa)
+    {
+        xs.push_back(x);
+        xs.push_back(x + 0.1);
+    }
+    return xs;
+}
+
+TEST_CASE("table.reference", "[interp]")
+{
+    for (bool force : { false, true })
+    {
+        for (bool flat : { false, true })
+        {
+            LinearInterp linear(xa, ya, force, flat, flat);
+            FlatForwardInterp flatForward(xa, ya, force, flat, flat);
+            ExpInterp exponential(xa, ya, force, flat, flat);
+            HermiteInterp hermite(xa, ya, force, flat, flat);
+
+            for (double x : samples())
+            {
+                REQUIRE( linear.interpolate(x) == Approx(LinearInterp::interpolate(x, xa, ya, force, flat, flat)).epsilon(1e-14) );
+                REQUIRE( flatForward.interpolate(x) == Approx(FlatForwardInterp::interpolate(x, xa, ya, force, flat, flat)).epsilon(1e-14) );
+                REQUIRE( exponential.interpolate(x) == Approx(ExpInterp::interpolate(x, xa, ya, force, flat, flat)).epsilon(1e-14) );
+                REQUIRE( hermite.interpolate(x) == Approx(HermiteInterp::interpolate(x, xa, ya, force, flat, flat)).epsilon(1e-14) );
+            }
+        }
+    }
+}
+
+TEST_CASE("exponential.nonPositive", "[interp]")
+{
+    // The log of a value which is not positive is not finite, so it is rejected.
+    std::vector<double> xs { 1.0, 2.0, 3.0 };
+    REQUIRE_THROWS_AS( ExpInterp(xs, {0.03, 0.0, 0.02}, false, false, false), std::invalid_argument );
+    REQUIRE_THROWS_AS( ExpInterp(xs, {0.03, -0.01, 0.02}, false, false, false), std::invalid_argument );
+
+    // A rejected value leaves the points as they were.
+    ExpInterp exponential(xs, {0.03, 0.025, 0.02}, false, false, false);
+    double before = exponential.interpolate(2.5);
+    REQUIRE_THROWS_AS( exponential.set(1, 0.0), std::invalid_argument );
+    REQUIRE_THROWS_AS( exponential.add(4.0, 0.0), std::invalid_argument );
+    REQUIRE( exponential.get_ya()[1] == 0.025 );
+    REQUIRE( exponential.get_xa().size() == 3 );
+    REQUIRE( exponential.interpolate(2.5) == before );
+    REQUIRE( std::isfinite(before) );
+}
+
+TEST_CASE("table.spline", "[interp]")
+{
+    SplineIterp spline(xa, ya, false, false, false, 1e30, 1e30);
+
+    for (size_t i = 0; i < xa.size(); ++i)
+        REQUIRE( spline.interpolate(xa[i]) == ya[i] );
+
+    // The cubic between the knots, from the second derivatives.
+    for (size_t i = 0; i + 1 < xa.size(); ++i)
+    {
+        double x = 0.5 * (xa[i] + xa[i+1]);
+        double h = xa[i+1] - xa[i];
+        double y = 0.5 * (ya[i] + ya[i+1]) - 0.375 * (spline.y2axis[i] + spline.y2axis[i+1]) * h * h / 6.0;
+        REQUIRE( spline.interpolate(x) == Approx(y).epsilon(1e-14) );
+    }
+}
+
+TEST_CASE("table.set", "[interp]")
+{
+    std::vector<double> moved = ya;
+    moved[4] = 0.05;
+
+    LinearInterp linear(xa, ya, true, true, false);
+    HermiteInterp hermite(xa, ya, true, true, false);
+    SplineIterp spline(xa, ya, true, true, false, 1e30, 1e30);
+    linear.set(4, 0.05);
+    hermite.set(4, 0.05);
+    spline.set(4, 0.05);
+
+    LinearInterp linearMoved(xa, moved, true, true, false);
+    HermiteInterp hermiteMoved(xa, moved, true, true, false);
+    SplineIterp splineMoved(xa, moved, true, true, false, 1e30, 1e30);
+
+    for (double x : samples())
+    {
+        REQUIRE( linear.interpolate(x) == linearMoved.interpolate(x) );
+        REQUIRE( hermite.interpolate(x) == hermiteMoved.interpolate(x) );
+        REQUIRE( spline.interpolate(x) == Approx(splineMoved.interpolate(x)).epsilon(1e-14) );
+    }
+}
+
+TEST_CASE("table.add", "[interp]")
+{
+    LinearInterp linear;
+    linear.add(xa[0], ya[0]);
+    REQUIRE( linear.interpolate(5.0) == ya[0] );
+
+    for (size_t i = 1; i < xa.size(); ++i)
+        linear.add(xa[i], ya[i]);
+
+    LinearInterp built(xa, ya, false, false, false);
+    for (double x : { 0.75, 4.0, 9.0 })
+        REQUIRE( linear.interpolate(x) == built.interpolate(x) );
+
+    REQUIRE_THROWS_AS( LinearInterp().interpolate(1.0), std::invalid_argument );
+}
+
+TEST_CASE("table.append", "[interp]")
+{
+    // Enough points for the index, added one at a time as a bootstrap does.
+    std::vector<double> many_xa, many_ya;
+    for (int i = 1; i <= 300; ++i)
+    {
+        many_xa.push_back(i / 12.0);
+        many_ya.push_back(0.03 + 0.01 * std::sin(i / 20.0));
+    }
+
+    std::vector<std::pair<std::shared_ptr<Interp>, std::shared_ptr<Interp>>> interps {
+        { std::make_shared<LinearInterp>(), std::make_shared<LinearInterp>(many_xa, many_ya, false, false, false) },
+        { std::make_shared<FlatForwardInterp>(), std::make_shared<FlatForwardInterp>(many_xa, many_ya, false, false, false) },
+        { std::make_shared<ExpInterp>(), std::make_shared<ExpInterp>(many_xa, many_ya, false, false, false) },
+        { std::make_shared<HermiteInterp>(), std::make_shared<HermiteInterp>(many_xa, many_ya, false, false, false) }
+    };
+
+    for (auto& [added, built] : interps)
+    {
+        for (size_t i = 0; i < many_xa.size(); ++i)
+            added->add(many_xa[i], many_ya[i]);
+
+        REQUIRE( added->get_table().indexed() );
+        for (double x = 0.0; x < 26.0; x += 0.013)
+        {
+            REQUIRE( added->get_table().find(x, 0) == PiecewisePolynomial::find_segment(many_xa, x, 0) );
+            REQUIRE( added->interpolate(x) == built->interpolate(x) );
+        }
+    }
+
+    SplineIterp spline({ many_xa[0], many_xa[1] }, { many_ya[0], many_ya[1] }, false, false, false, 1e30, 1e30);
+    for (size_t i = 2; i < many_xa.size(); ++i)
+        spline.add(many_xa[i], many_ya[i]);
+
+    SplineIterp builtSpline(many_xa, many_ya, false, false, false, 1e30, 1e30);
+    for (double x = 0.0; x < 26.0; x += 0.013)
+        REQUIRE( spline.interpolate(x) == Approx(builtSpline.interpolate(x)).epsilon(1e-12) );
+}
+
+TEST_CASE("table.index", "[interp]")
+{
+    // Daily knots over ten years.
+    std::vector<double> daily_xa, daily_ya;
+    for (int i = 1; i <= 3650; ++i)
+    {
+        daily_xa.push_back(i / 365.0);
+        daily_ya.push_back(0.03 + 0.01 * std::sin(i / 200.0));
+    }
+
+    LinearInterp daily(daily_xa, daily_ya, false, true, false);
+    const auto& table = daily.get_table();
+    REQUIRE( table.indexed() );
+    REQUIRE_FALSE( LinearInterp(xa, ya, false, true, false).get_table().indexed() );
+
+    // The index finds the same segments as the binary search, from any hint.
+    std::vector<double> xs { 0.0, daily_xa.front(), daily_xa.back(), 11.0 };
+    for (int i = 0; i < 20000; ++i)
+        xs.push_back(i * 0.000503);
+    for (double x : daily_xa)
+        xs.push_back(x);
+
+    for (double x : xs)
+    {
+        size_t expected = PiecewisePolynomial::find_segment(daily_xa, x, 0);
+        REQUIRE( table.find(x, 0) == expected );
+        REQUIRE( table.find(x, daily_xa.size() - 2) == expected );
+        REQUIRE( daily.interpolate(x) == Approx(LinearInterp::interpolate(x, daily_xa, daily_ya, false, true, false)).epsilon(1e-14) );
+    }
+
+    // Knots bunched at the front are not indexed.
+    std::vector<double> bunched_xa, bunched_ya;
+    for (int i = 1; i <= 200; ++i)
+    {
+        bunched_xa.push_back(i < 190 ? i / 3650.0 : i - 180.0);
+        bunched_ya.push_back(0.03);
+    }
+    REQUIRE_FALSE( LinearInterp(bunched_xa, bunched_ya, false, true, false).get_table().indexed() );
+}
+
+TEST_CASE("spline.inplace", "[interp]")
+{
+    SplineIterp built(xa, ya, true, true, false, 0, 0);
+
+    SplineIterp spline({ xa[0], xa[1] }, { ya[0], ya[1] }, true, true, false, 0, 0);
+    spline.reserve(xa.size());
+
+    // Adding points and solving for them, as a bootstrap does, allocates nothing.
+    size_t before = allocations;
+    for (size_t i = 2; i < xa.size(); ++i)
+    {
+        spline.add(xa[i], 0.05);
+        for (double y : { 0.04, 0.045, ya[i] })
+            spline.set_last(y);
+    }
+    REQUIRE( allocations == before );
+
+    for (size_t i = 0; i < xa.size(); ++i)
+        REQUIRE( spline.y2axis[i] == built.y2axis[i] );
+
+    for (double x : samples())
+    {
+        REQUIRE( spline.interpolate(x) == built.interpolate(x) );
+        REQUIRE( spline.last_weight(x) == built.last_weight(x) );
+    }
+}
+
+// The weights against central differences, building the interpolator again with each point bumped.
+template <typename Make>
+static void check_weights(Make make, size_t max_nonzero)
+{
+    const double bump = 1e-6;
+    auto interp = make(ya);
+
+    for (double x : samples())
+    {
+        std::vector<double> weights(xa.size(), 0.0);
+        interp->add_weights(x, weights, 2.0);
+
+        size_t nonzero = 0;
+        for (size_t i = 0; i < xa.size(); ++i)
+        {
+            std::vector<double> up = ya, down = ya;
+            up[i] += bump;
+            down[i] -= bump;
+            double difference = (make(up)->interpolate(x) - make(down)->interpolate(x)) / (2.0 * bump);
+
+            REQUIRE( weights[i] == Approx(2.0 * difference).margin(1e-8) );
+            nonzero += weights[i] != 0.0;
+        }
+
+        REQUIRE( nonzero <= max_nonzero );
+        REQUIRE( weights.back() == Approx(2.0 * interp->last_weight(x)).margin(1e-12) );
+    }
+}
+
+TEST_CASE("weights", "[interp]")
+{
+    for (bool force : { false, true })
+    {
+        for (bool flat : { false, true })
+        {
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<LinearInterp>(xa, y, force, flat, flat); }, 2);
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<FlatForwardInterp>(xa, y, force, flat, flat); }, 2);
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<ExpInterp>(xa, y, force, flat, flat); }, 2);
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<HermiteInterp>(xa, y, force, flat, flat); }, 4);
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<SplineIterp>(xa, y, force, flat, flat, 1e30, 1e30); }, xa.size());
+            check_weights([=](const std::vector<double>& y) { return std::make_shared<SplineIterp>(xa, y, force, flat, flat, 0.01, -0.02); }, xa.size());
+        }
+    }
+
+    std::vector<double> weights(xa.size() - 1);
+    REQUIRE_THROWS_AS( LinearInterp(xa, ya, false, true, true).add_weights(1.0, weights), std::invalid_argument );
+}
@@ -0,0 +1,88 @@
+#include "maths/simd.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+
+using namespace maths;
+
+// The number of doubles between a and b, which have the same sign.
+static double ulps(double a, double b)
+{
+    auto ia = std::bit_cast<std::int64_t>(a), ib = std::bit_cast<std::int64_t>(b);
+    return static_cast<double>(ia > ib ? ia - ib : ib - ia);
+}
+
+TEST_CASE("exp", "[simd]")
+{
+    std::mt19937_64 engine(42);
+    std::uniform_real_distribution<double> wide(simd::exp_min, simd::exp_max);
+    std::uniform_real_distribution<double> narrow(-1.0, 1.0);
+
+    std::vector<double> xs { 0.0, -0.0, 1.0, -1.0, 0.5 * std::log(2.0), simd::exp_min, simd::exp_max };
+    for (int i = 0; i < 100000; ++i)
+    {
+        xs.push_back(wide(engine));
+        xs.push_back(narrow(engine));
+    }
+
+    std::vector<double> ys(xs.size());
+    simd::exp(xs, ys);
+
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        REQUIRE( ys[i] == simd::exp(xs[i]) );
+        REQUIRE( ulps(ys[i], std::exp(xs[i])) <= simd::exp_max_ulp );
+    }
+}
+
+TEST_CASE("exp.limits", "[simd]")
+{
+    REQUIRE( simd::exp(0.0) == 1.0 );
+    REQUIRE( simd::exp(1000.0) == std::numeric_limits<double>::infinity() );
+    REQUIRE( simd::exp(std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity() );
+    REQUIRE( simd::exp(-1000.0) == 0.0 );
+    REQUIRE( simd::exp(-std::numeric_limits<double>::infinity()) == 0.0 );
+    REQUIRE( std::isnan(simd::exp(std::numeric_limits<double>::quiet_NaN())) );
+}
+
+TEST_CASE("exp.inplace", "[simd]")
+{
+    std::vector<double> xs { -2.0, -1.0, 0.0, 1.0, 2.0 };
+    std::vector<double> ys = xs;
+    simd::exp(ys, ys);
+
+    for (size_t i = 0; i < xs.size(); ++i)
+        REQUIRE( ys[i] == simd::exp(xs[i]) );
+
+    std::vector<double> short_ys(2);
+    REQUIRE_THROWS_AS( simd::exp(xs, short_ys), std::invalid_argument );
+}
+
+// Run with "make bench". The gain comes from the vector width the build targets (see OPT in the Makefile).
+TEST_CASE("exp.benchmark", "[simd][.benchmark]")
+{
+    std::vector<double> xs(4096), ys(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i)
+        xs[i] = -0.05 * 30.0 * i / xs.size();
+
+    BENCHMARK("simd::exp")
+    {
+        simd::exp(xs, ys);
+        return ys.back();
+    };
+
+    BENCHMARK("std::exp")
+    {
+        for (size_t i = 0; i < xs.size(); ++i)
+            ys[i] = std::exp(xs[i]);
+        return ys.back();
+    };
+}
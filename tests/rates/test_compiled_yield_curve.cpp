@@ -0,0 +1,107 @@
+#include "rates/compiled_yield_curve.hpp"
+#include "rates/yield_curve.hpp"
+#include "rates/deposit.hpp"
+#include "rates/ir_future.hpp"
+#include "rates/ir_swap.hpp"
+
+#include "dates/calendars/target.hpp"
+
+#include <chrono>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+static void requireSameCurve(const YieldCurve& curve, const CompiledYieldCurve& compiled)
+{
+    for (double t = 0.0; t < 12.0; t += 0.05)
+    {
+        REQUIRE( compiled.rate(t) == Approx(curve.rate(t)).epsilon(1e-12) );
+        REQUIRE( compiled.discountFactor(t) == Approx(curve.discountFactor(t)).epsilon(1e-12) );
+        REQUIRE( compiled.forwardRate(t, t + 0.25) == Approx(curve.forwardRate(t, t + 0.25)).epsilon(1e-10) );
+    }
+}
+
+static YieldCurve makeCurve(EInterpolationMethod interpolationMethod)
+{
+    return YieldCurve{
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059}, {5.0, 0.065}, {10.0, 0.07} },
+        2026y / January / 9d,
+        EDayCount::Actual_d365,
+        interpolationMethod
+    };
+}
+
+TEST_CASE("flatRate", "[compiled_yield_curve]")
+{
+    auto curve = YieldCurve{0.05, 2026y / January / 9d, EDayCount::Actual_d365};
+    auto compiled = CompiledYieldCurve{curve};
+
+    REQUIRE( compiled.knots().size() == 1 );
+    requireSameCurve(curve, compiled);
+}
+
+TEST_CASE("spreadView", "[compiled_yield_curve]")
+{
+    // A spread is not a polynomial in the rates of the points.
+    auto curve = makeCurve(EInterpolationMethod::Linear);
+    REQUIRE_THROWS_AS( CompiledYieldCurve{curve.withSpread(0.01)}, std::invalid_argument );
+}
+
+TEST_CASE("linear", "[compiled_yield_curve]")
+{
+    auto curve = makeCurve(EInterpolationMethod::Linear);
+    requireSameCurve(curve, CompiledYieldCurve{curve});
+}
+
+TEST_CASE("flatForward", "[compiled_yield_curve]")
+{
+    auto curve = makeCurve(EInterpolationMethod::FlatForward);
+    requireSameCurve(curve, CompiledYieldCurve{curve});
+}
+
+TEST_CASE("cubicSpline", "[compiled_yield_curve]")
+{
+    auto curve = makeCurve(EInterpolationMethod::CubicSpline);
+    requireSameCurve(curve, CompiledYieldCurve{curve});
+}
+
+TEST_CASE("hermite", "[compiled_yield_curve]")
+{
+    auto curve = makeCurve(EInterpolationMethod::Hermite);
+    requireSameCurve(curve, CompiledYieldCurve{curve});
+}
+
+TEST_CASE("exponential", "[compiled_yield_curve]")
+{
+    auto curve = makeCurve(EInterpolationMethod::Exponential);
+    auto compiled = CompiledYieldCurve{curve};
+
+    REQUIRE( compiled.form() == CompiledYieldCurve::EForm::LogRate );
+    requireSameCurve(curve, compiled);
+}
+
+TEST_CASE("bootstrap", "[compiled_yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    auto compiled = CompiledYieldCurve{curve};
+
+    REQUIRE( compiled.valueDate() == curve.valueDate() );
+    REQUIRE( compiled.timeGrid() == curve.timeGrid() );
+    REQUIRE( compiled.time(2000y/January/1d) == curve.time(2000y/January/1d) );
+    REQUIRE( compiled.discountFactor(2000y/January/1d) == Approx(curve.discountFactor(2000y/January/1d)).epsilon(1e-12) );
+    REQUIRE( compiled.fix(1998y/January/8d, 1998y/April/8d, EDayCount::Actual_d360) == Approx(curve.fix(1998y/January/8d, 1998y/April/8d, EDayCount::Actual_d360)).epsilon(1e-10) );
+}
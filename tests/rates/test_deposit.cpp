@@ -54,6 +54,42 @@ TEST_CASE("value", "deposit")
     REQUIRE( actual == Approx(expected).epsilon(1e-12) );
 }
 
+TEST_CASE("valueDerivative", "deposit")
+{
+    auto deposit = Deposit{1e6, 0.05, 2026y/January/5d, 2026y/March/5d, EDayCount::Actual_d365};
+    auto points = std::vector<YieldCurvePoint>{ {0.01, 0.05}, {0.1, 0.052}, {0.2, 0.051} };
+    auto curve = YieldCurve{points, 2026y/January/2d, EDayCount::Actual_d365, EInterpolationMethod::Linear};
+
+    double h = 1e-6;
+    auto up = curve;
+    up.setLastRate(0.051 + h);
+    auto down = curve;
+    down.setLastRate(0.051 - h);
+    double expected = (deposit.value(up) - deposit.value(down)) / (2 * h);
+
+    REQUIRE( deposit.valueDerivative(curve) == Approx(expected).epsilon(1e-6) );
+}
+
+TEST_CASE("value/twoCurves", "deposit")
+{
+    auto deposit = Deposit{1e6, 0.05, 2026y/January/5d, 2026y/March/5d, EDayCount::Actual_d365};
+    auto points = std::vector<YieldCurvePoint>{ {0.01, 0.05}, {0.1, 0.052}, {0.2, 0.051} };
+    auto curve = YieldCurve{points, 2026y/January/2d, EDayCount::Actual_d365, EInterpolationMethod::Linear};
+    auto copy = curve;
+
+    // Two curves are priced as two curves whether or not they are the same object.
+    REQUIRE( deposit.value(curve, curve) == deposit.value(curve, copy) );
+    REQUIRE( deposit.valueDerivative(curve, curve) == deposit.valueDerivative(curve, copy) );
+    // On one curve the values agree, but the derivative through the forward curve alone leaves out the discounting.
+    REQUIRE( deposit.value(curve, curve) == Approx(deposit.value(curve)).epsilon(1e-10) );
+    REQUIRE( deposit.valueDerivative(curve, curve) != Approx(deposit.valueDerivative(curve)).epsilon(1e-6) );
+
+    // The curve being bootstrapped chooses single curve pricing.
+    REQUIRE( !curve.isProjectionCurve() );
+    REQUIRE( deposit.bootstrapValue(curve) == deposit.value(curve) );
+    REQUIRE( deposit.bootstrapValueDerivative(curve) == deposit.valueDerivative(curve) );
+}
+
 TEST_CASE("calculateZeroRate", "deposit")
 {
     auto deposit = Deposit{1e6, 0.05, 2026y/January/5d, 2026y/March/5d, EDayCount::Actual_d365};
@@ -0,0 +1,134 @@
+#include "rates/forward_strip.hpp"
+#include "rates/yield_curve.hpp"
+#include "rates/ir_swap.hpp"
+
+#include "dates/calendars/target.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+TEST_CASE("fix", "[forward_strip]")
+{
+    auto strip = ForwardStrip{100};
+    REQUIRE( strip.capacity() == 128 );
+
+    int computed = 0;
+    auto compute = [&]() { ++computed; return 0.05; };
+
+    REQUIRE( strip.fix(2026y/January/9d, 2026y/April/9d, EDayCount::Actual_d360, compute) == 0.05 );
+    REQUIRE( strip.fix(2026y/January/9d, 2026y/April/9d, EDayCount::Actual_d360, compute) == 0.05 );
+    REQUIRE( computed == 1 );
+    REQUIRE( strip.hits() == 1 );
+    REQUIRE( strip.misses() == 1 );
+
+    // The day count is part of the key.
+    strip.fix(2026y/January/9d, 2026y/April/9d, EDayCount::Actual_d365, compute);
+    REQUIRE( computed == 2 );
+    REQUIRE( strip.size() == 2 );
+}
+
+TEST_CASE("full", "[forward_strip]")
+{
+    auto strip = ForwardStrip{1};
+
+    int computed = 0;
+    auto compute = [&]() { ++computed; return 0.05; };
+
+    strip.fix(2026y/January/9d, 2026y/April/9d, EDayCount::Actual_d360, compute);
+    strip.fix(2026y/April/9d, 2026y/July/9d, EDayCount::Actual_d360, compute);
+    strip.fix(2026y/April/9d, 2026y/July/9d, EDayCount::Actual_d360, compute);
+
+    // Periods which do not fit are computed every time.
+    REQUIRE( strip.size() == 1 );
+    REQUIRE( computed == 3 );
+    REQUIRE( strip.hits() == 0 );
+    REQUIRE( strip.misses() == 3 );
+    REQUIRE( strip.overflows() == 2 );
+}
+
+TEST_CASE("racing", "[forward_strip]")
+{
+    auto strip = ForwardStrip{16};
+
+    std::atomic<int> computed = 0;
+    auto compute = [&]()
+    {
+        ++computed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return 0.05;
+    };
+
+    // The threads which find the period being written wait for its rate.
+    std::vector<double> rates(8);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < rates.size(); ++i)
+            threads.emplace_back([&, i]() { rates[i] = strip.fix(2026y/January/9d, 2026y/April/9d, EDayCount::Actual_d360, compute); });
+    }
+
+    for (auto rate : rates)
+        REQUIRE( rate == 0.05 );
+    REQUIRE( computed == 1 );
+    REQUIRE( strip.size() == 1 );
+    REQUIRE( strip.hits() == rates.size() - 1 );
+
+    // A rate which cannot be computed leaves the slot for the next lookup of the period to skip.
+    auto fail = []() -> double { throw std::range_error("no rate"); };
+    REQUIRE_THROWS_AS( strip.fix(2026y/April/9d, 2026y/July/9d, EDayCount::Actual_d360, fail), std::range_error );
+    REQUIRE( strip.fix(2026y/April/9d, 2026y/July/9d, EDayCount::Actual_d360, compute) == 0.05 );
+    REQUIRE( strip.size() == 2 );
+}
+
+TEST_CASE("curve", "[forward_strip]")
+{
+    auto valueDate = 2026y/January/9d;
+    auto holidays = calendars::targetHolidays(year{2026}, year{2026} + years{20});
+
+    auto curve = YieldCurve(
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059}, {5.0, 0.065}, {10.0, 0.07} },
+        valueDate,
+        EDayCount::Actual_d365,
+        EInterpolationMethod::CubicSpline);
+
+    auto swaps = std::vector<IrSwap> {
+        IrSwap(1e6, 0.06, 0.0, valueDate, years{5}, EFrequency::Quarterly, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d360, days{0}, holidays),
+        IrSwap(2e6, 0.061, 0.0, valueDate, years{5}, EFrequency::Quarterly, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d360, days{0}, holidays),
+        IrSwap(1e6, 0.058, 0.0, valueDate, years{3}, EFrequency::Quarterly, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d360, days{0}, holidays)
+    };
+
+    std::vector<double> expected;
+    for (const auto& swap : swaps)
+        expected.push_back(swap.value(curve));
+
+    auto cached = curve;
+    cached.cacheFixings();
+    REQUIRE( curve.forwardStrip() == nullptr );
+
+    // Priced concurrently, the swaps share the fixing periods.
+    std::vector<double> values(swaps.size() * 4);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < values.size(); ++i)
+            threads.emplace_back([&, i]() { values[i] = swaps[i % swaps.size()].value(cached); });
+    }
+
+    for (size_t i = 0; i < values.size(); ++i)
+        REQUIRE( values[i] == expected[i % swaps.size()] );
+    REQUIRE( cached.forwardStrip()->size() >= swaps.front().floatingLeg().fixingSchedule().size() );
+    REQUIRE( cached.forwardStrip()->size() < 2 * swaps.front().floatingLeg().fixingSchedule().size() );
+    // Each period is computed once.
+    REQUIRE( cached.forwardStrip()->misses() == cached.forwardStrip()->size() );
+    REQUIRE( cached.forwardStrip()->overflows() == 0 );
+
+    // Changing the curve drops the strip.
+    cached.setLastRate(0.08);
+    REQUIRE( cached.forwardStrip() == nullptr );
+}
@@ -1,4 +1,5 @@
 #include "rates/ir_swap.hpp"
+#include "rates/yield_curve.hpp"
 
 #include <chrono>
 
@@ -52,3 +53,43 @@ TEST_CASE("ctor.tenor", "[ir_swap]")
     REQUIRE ( swap.floatingLeg().firstAccrualDate() == 2000y/January/1d );
     REQUIRE ( swap.floatingLeg().maturityDate() == 2002y/January/1d );
 }
+
+TEST_CASE("valueDerivative", "[ir_swap]")
+{
+    auto valueDate = 2000y/January/1d;
+    auto swap = IrSwap(1e6, 0.06, 0.0, valueDate, years{3}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, {});
+
+    auto points = std::vector<YieldCurvePoint>{ {0.25, 0.05}, {1.0, 0.055}, {2.0, 0.058}, {3.0, 0.06} };
+    auto curve = YieldCurve{points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline};
+
+    double h = 1e-6;
+    auto up = curve;
+    up.setLastRate(0.06 + h);
+    auto down = curve;
+    down.setLastRate(0.06 - h);
+    double expected = (swap.value(up) - swap.value(down)) / (2 * h);
+
+    REQUIRE( swap.valueDerivative(curve) == Approx(expected).epsilon(1e-6) );
+}
+
+TEST_CASE("valueDerivative/twoCurves", "[ir_swap]")
+{
+    auto valueDate = 2000y/January/1d;
+    auto swap = IrSwap(1e6, 0.06, 0.0, valueDate, years{3}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, {});
+
+    auto points = std::vector<YieldCurvePoint>{ {0.25, 0.05}, {1.0, 0.055}, {2.0, 0.058}, {3.0, 0.06} };
+    auto curve = YieldCurve{points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline};
+    auto copy = curve;
+
+    // Only the projected rates move with the forward curve, whether or not it is the discount curve.
+    double h = 1e-6;
+    auto up = curve;
+    up.setLastRate(0.06 + h);
+    auto down = curve;
+    down.setLastRate(0.06 - h);
+    double expected = (swap.value(curve, up) - swap.value(curve, down)) / (2 * h);
+
+    REQUIRE( swap.valueDerivative(curve, copy) == Approx(expected).epsilon(1e-6) );
+    REQUIRE( swap.valueDerivative(curve, curve) == swap.valueDerivative(curve, copy) );
+    REQUIRE( swap.value(curve, copy) == Approx(swap.value(curve)).epsilon(1e-12) );
+}
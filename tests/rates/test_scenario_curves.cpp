@@ -0,0 +1,82 @@
+#include "rates/scenario_curves.hpp"
+#include "rates/yield_curve.hpp"
+#include "rates/deposit.hpp"
+#include "rates/ir_swap.hpp"
+
+#include "dates/calendars/target.hpp"
+
+#include <chrono>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+static const auto valueDate = 2026y / January / 9d;
+static const auto points = std::vector<YieldCurvePoint>{ {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059}, {5.0, 0.065}, {10.0, 0.07} };
+
+// Each scenario is the base curve twisted by a different amount.
+static std::vector<YieldCurve> makeScenarios(ScenarioCurves& scenarios, EInterpolationMethod interpolationMethod)
+{
+    std::vector<YieldCurve> curves;
+    for (size_t s = 0; s < scenarios.scenarioCount(); ++s)
+    {
+        auto scenarioPoints = points;
+        std::vector<double> rates;
+        for (auto& point : scenarioPoints)
+        {
+            point.rate(point.rate() + 0.001 * s * (point.time() - 3.0));
+            rates.push_back(point.rate());
+        }
+        scenarios.setRates(s, rates);
+        curves.push_back(YieldCurve(scenarioPoints, valueDate, EDayCount::Actual_d365, interpolationMethod));
+    }
+    return curves;
+}
+
+TEST_CASE("discountFactors", "[scenario_curves]")
+{
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::CubicSpline, EInterpolationMethod::Hermite })
+    {
+        auto base = YieldCurve(points, valueDate, EDayCount::Actual_d365, interpolationMethod);
+        auto scenarios = ScenarioCurves(base, 5);
+        auto curves = makeScenarios(scenarios, interpolationMethod);
+
+        std::vector<double> dfs(scenarios.scenarioCount());
+        for (double t = 0.0; t < 12.0; t += 0.1)
+        {
+            scenarios.discountFactors(t, dfs);
+            for (size_t s = 0; s < curves.size(); ++s)
+                REQUIRE( dfs[s] == Approx(curves[s].discountFactor(t)).epsilon(1e-12) );
+        }
+    }
+}
+
+TEST_CASE("exponential", "[scenario_curves]")
+{
+    auto base = YieldCurve(points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::Exponential);
+    REQUIRE_THROWS_AS( ScenarioCurves(base, 2), std::invalid_argument );
+}
+
+TEST_CASE("values", "[scenario_curves]")
+{
+    auto holidays = calendars::targetHolidays(year{2026}, year{2026} + years{10});
+
+    auto base = YieldCurve(points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    auto scenarios = ScenarioCurves(base, 4);
+    auto curves = makeScenarios(scenarios, EInterpolationMethod::CubicSpline);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.0 / 100, valueDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.0 / 100, 0.001, valueDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    std::vector<double> pvs(scenarios.scenarioCount());
+    for (const auto& instrument : instruments)
+    {
+        instrument->values(scenarios, pvs);
+        for (size_t s = 0; s < curves.size(); ++s)
+            REQUIRE( pvs[s] == Approx(instrument->value(curves[s])).epsilon(1e-9).margin(1e-6) );
+    }
+}
@@ -0,0 +1,64 @@
+#include "rates/time_grid.hpp"
+
+#include <chrono>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+static void requireSameTimes(EDayCount dayCount, int horizonDays = 366 * 5)
+{
+    auto valueDate = 2024y / February / 27d;
+    auto grid = TimeGrid{valueDate, dayCount, horizonDays};
+
+    // Straddle the value date and the end of the table.
+    for (int offset = -400; offset < horizonDays + 366; offset += 7)
+    {
+        auto date = year_month_day{sys_days{valueDate} + days{offset}};
+        REQUIRE( grid.time(date) == yearFrac(valueDate, date, dayCount) );
+    }
+}
+
+TEST_CASE("closedForm", "[time_grid]")
+{
+    REQUIRE( TimeGrid{2024y / February / 27d, EDayCount::Actual_d360}.isClosedForm() );
+    requireSameTimes(EDayCount::Actual_d360);
+    requireSameTimes(EDayCount::Actual_d365);
+    requireSameTimes(EDayCount::Actual_d366);
+    requireSameTimes(EDayCount::Actual_d365_25);
+}
+
+TEST_CASE("table", "[time_grid]")
+{
+    REQUIRE( !TimeGrid{2024y / February / 27d, EDayCount::d30A_360}.isClosedForm() );
+    requireSameTimes(EDayCount::d30A_360);
+    requireSameTimes(EDayCount::d30E_d360);
+    requireSameTimes(EDayCount::Actual_Actual_ISDA);
+
+    // The last chunk of the table is partly filled.
+    requireSameTimes(EDayCount::d30A_360, 500);
+}
+
+TEST_CASE("shared", "[time_grid]")
+{
+    auto grid = TimeGrid::shared(2024y / February / 27d, EDayCount::d30A_360);
+    REQUIRE( TimeGrid::shared(2024y / February / 27d, EDayCount::d30A_360) == grid );
+    REQUIRE( TimeGrid::shared(2024y / February / 28d, EDayCount::d30A_360) != grid );
+    REQUIRE( TimeGrid::shared(2024y / February / 27d, EDayCount::Actual_Actual_ISDA) != grid );
+    REQUIRE( grid->horizonDays() == TimeGrid::DefaultHorizonDays );
+}
+
+TEST_CASE("times", "[time_grid]")
+{
+    auto valueDate = 2024y / February / 27d;
+    auto grid = TimeGrid{valueDate, EDayCount::d30A_360};
+    auto dates = std::vector<year_month_day>{ 2024y / May / 27d, 2024y / August / 27d, 2034y / February / 28d };
+
+    auto ts = grid.times(dates);
+
+    REQUIRE( ts.size() == dates.size() );
+    for (size_t i = 0; i < dates.size(); ++i)
+        REQUIRE( ts[i] == yearFrac(valueDate, dates[i], EDayCount::d30A_360) );
+}
@@ -125,3 +125,53 @@ TEST_CASE("fixings/yieldCurve", "[value]")
     );
     REQUIRE ( actual == Approx(1009728.5234190911).epsilon(1e-10) );
 }
+
+TEST_CASE("singleDate/yieldCurve", "[value]")
+{
+    auto valueDate = 2026y/January/9d;
+    auto curve = YieldCurve{0.05, valueDate, EDayCount::Actual_d365};
+    auto schedule = std::vector<year_month_day> { 2026y/July/1d };
+    auto notional = 1000000.0;
+
+    // With no periods only the notional is paid.
+    double expected = notional * curve.discountFactor(valueDate, schedule.back());
+    REQUIRE( rates::value(valueDate, curve, schedule, EDayCount::Actual_d365, 0.08, notional) == Approx(expected).epsilon(1e-14) );
+    REQUIRE( rates::value(valueDate, curve, schedule, EDayCount::Actual_d365, std::vector<double>{}, notional) == Approx(expected).epsilon(1e-14) );
+}
+
+TEST_CASE("valueDerivative/yieldCurve", "[value]")
+{
+    auto valueDate = 2026y/January/9d;
+    auto curve = YieldCurve(
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059} },
+        valueDate,
+        EDayCount::Actual_d365,
+        EInterpolationMethod::CubicSpline);
+    auto schedule = std::vector<year_month_day> {
+        2026y/January/1d,
+        2026y/April/1d,
+        2026y/July/1d,
+        2026y/October/1d,
+        2027y/January/1d,
+        2027y/April/1d
+    };
+    auto dayCount = EDayCount::Actual_d365;
+    auto notional = 1000000.0;
+    auto fixingRates = std::vector<double> { 0.05, 0.051, 0.052, 0.053, 0.054 };
+    auto fixingRateDerivatives = std::vector<double> { 0.0, 0.1, 0.2, 0.3, 0.4 };
+
+    // The derivative of each period, looked up date by date.
+    double fixed = notional * curve.discountFactorDerivative(valueDate, schedule.back());
+    double floating = fixed;
+    for (size_t i = 1; i < schedule.size(); ++i)
+    {
+        double t = yearFrac(schedule[i-1], schedule[i], dayCount);
+        double df = curve.discountFactor(valueDate, schedule[i]);
+        double dDf = curve.discountFactorDerivative(valueDate, schedule[i]);
+        fixed += notional * t * 0.08 * dDf;
+        floating += notional * t * (fixingRateDerivatives[i-1] * df + fixingRates[i-1] * dDf);
+    }
+
+    REQUIRE( rates::valueDerivative(valueDate, curve, schedule, dayCount, 0.08, notional) == Approx(fixed).epsilon(1e-14) );
+    REQUIRE( rates::valueDerivative(valueDate, curve, schedule, dayCount, fixingRates, fixingRateDerivatives, notional) == Approx(floating).epsilon(1e-14) );
+}
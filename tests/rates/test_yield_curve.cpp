@@ -6,6 +6,7 @@
 #include "dates/calendars/target.hpp"
 
 #include <chrono>
+#include <cmath>
 
 #define CATCH_CONFIG_MAIN
 #include "catch2/catch.hpp"
@@ -44,6 +45,55 @@ TEST_CASE("ctor.flatRate", "[yield_curve]")
     REQUIRE (yc.points().at(0) == YieldCurvePoint{1.0, 0.05});
 }
 
+TEST_CASE("batch", "[yield_curve]")
+{
+    auto valueDate = 2026y / January / 9d;
+    auto yc = YieldCurve{
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.065} },
+        valueDate,
+        EDayCount::Actual_d365,
+        EInterpolationMethod::CubicSpline
+    };
+
+    auto dates = std::vector<year_month_day>{ valueDate, 2026y / March / 9d, 2026y / July / 9d, 2027y / January / 11d, 2028y / July / 10d };
+    auto rs = std::vector<double>(dates.size());
+    auto dfs = std::vector<double>(dates.size());
+    auto fwds = std::vector<double>(dates.size() - 1);
+
+    yc.rates(dates, rs);
+    yc.discountFactors(dates, dfs);
+    yc.forwardRates(dates, fwds);
+
+    for (size_t i = 0; i < dates.size(); ++i)
+    {
+        REQUIRE( rs[i] == yc.rate(dates[i]) );
+        REQUIRE( dfs[i] == yc.discountFactor(dates[i]) );
+    }
+    for (size_t i = 0; i < fwds.size(); ++i)
+        REQUIRE( fwds[i] == Approx(yc.forwardRate(dates[i], dates[i+1])).epsilon(1e-15) );
+
+    REQUIRE_THROWS_AS( yc.discountFactors(dates, fwds), std::invalid_argument );
+}
+
+TEST_CASE("setLastRate", "[yield_curve]")
+{
+    auto points = std::vector<YieldCurvePoint>{ {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.065} };
+    auto valueDate = 2026y / January / 9d;
+
+    auto yc = YieldCurve{points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline};
+    auto copy = yc;
+    copy.setLastRate(0.07);
+
+    points.back().rate(0.07);
+    auto expected = YieldCurve{points, valueDate, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline};
+
+    for (double t : {0.05, 0.3, 0.75, 1.5, 2.0, 3.0})
+    {
+        REQUIRE( copy.rate(t) == Approx(expected.rate(t)).epsilon(1e-12) );
+    }
+    REQUIRE( yc.rate(2.0) == Approx(0.065).epsilon(1e-12) );
+}
+
 /*
 ype	Settlement date	Rate (%)
 Cash	Overnight rate	5.58675
@@ -104,4 +154,559 @@ TEST_CASE("bootstrap", "[yield_curve]")
 
     auto df1 = yieldCurve1.discountFactor(2000y/January/1d);
     REQUIRE ( df1 == Approx(0.87484318856686527).epsilon(1e-12) );
-}
\ No newline at end of file
+}
+
+TEST_CASE("bootstrap.global", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto daysToSpot = days{2};
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrFuture>(1e6, 100 - 5.82, 1998y/June, EDayCount::Actual_d365, EDateRule::Following, daysToSpot, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.42 / 100, 0.0, spotDate, years{10}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto yieldCurve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline, EBootstrapMethod::Global);
+
+    REQUIRE( yieldCurve.bootstrapMethod() == EBootstrapMethod::Global );
+    for (const auto& instrument : instruments)
+        REQUIRE( instrument->value(yieldCurve) == Approx(0.0).margin(1e-6) );
+
+    auto bumpedCurve = yieldCurve.bumpInstruments(0.0001);
+    REQUIRE( bumpedCurve.bootstrapMethod() == EBootstrapMethod::Global );
+}
+
+TEST_CASE("bumpInstrumentLadder", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto yieldCurve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    auto ladder = yieldCurve.bumpInstrumentLadder(0.0001, 2);
+
+    REQUIRE( ladder.size() == instruments.size() );
+    for (size_t i = 0; i < instruments.size(); ++i)
+    {
+        auto bumped = instruments;
+        bumped[i] = instruments[i]->clone_shared();
+        bumped[i]->rate(bumped[i]->rate() + 0.0001);
+        auto expected = YieldCurve(valueDate, bumped, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+
+        for (auto date : { 1997y/December/1d, 1999y/June/1d, 2002y/October/8d })
+            REQUIRE( ladder[i].discountFactor(date) == Approx(expected.discountFactor(date)).epsilon(1e-12) );
+    }
+
+    // The instruments of the base curve are left unchanged.
+    REQUIRE( instruments[0]->rate() == 5.625 / 100 );
+}
+
+TEST_CASE("instrumentDeltas", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto portfolio = IrSwap(5e6, 6.0 / 100, 0.0, spotDate, years{3}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays);
+    auto value = [&](const YieldCurve& curve) { return portfolio.value(curve); };
+
+    for (auto [interpolationMethod, bootstrapMethod] : {
+        std::pair{ EInterpolationMethod::Linear, EBootstrapMethod::Sequential },
+        std::pair{ EInterpolationMethod::CubicSpline, EBootstrapMethod::Global } })
+    {
+        auto yieldCurve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, interpolationMethod, bootstrapMethod);
+        auto deltas = yieldCurve.instrumentDeltas(yieldCurve.zeroRateDeltas(value));
+
+        const double bump = 1e-6;
+        auto ladder = yieldCurve.bumpInstrumentLadder(bump);
+        double pv = value(yieldCurve);
+
+        REQUIRE( deltas.size() == instruments.size() );
+        for (size_t i = 0; i < instruments.size(); ++i)
+            REQUIRE( deltas[i] == Approx((value(ladder[i]) - pv) / bump).epsilon(1e-4).margin(1.0) );
+    }
+
+    // A sequential bootstrap does not reprice the earlier instruments of a non-local curve.
+    auto sequential = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    REQUIRE_THROWS_AS( sequential.instrumentDeltas(sequential.zeroRateDeltas(value)), std::logic_error );
+}
+
+TEST_CASE("zeroRateDeltas.analytic", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.42 / 100, 0.0, spotDate, years{10}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto portfolio = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<IrSwap>(5e6, 6.0 / 100, 0.0, spotDate, years{7}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<Deposit>(2e6, 5.8 / 100, spotDate, months{6}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrFuture>(1e6, 100 - 5.76, 1997y/December, EDayCount::Actual_d365, EDateRule::Following, days{2}, holidays)
+    };
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::Exponential, EInterpolationMethod::Hermite, EInterpolationMethod::CubicSpline })
+    {
+        auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, interpolationMethod, EBootstrapMethod::Global);
+
+        for (const auto& instrument : portfolio)
+        {
+            // The analytic deltas come with the value, and match bumping each point.
+            std::vector<double> deltas(curve.points().size(), 0.0);
+            double pv = instrument->value(curve, deltas);
+            REQUIRE( pv == Approx(instrument->value(curve)).epsilon(1e-12) );
+
+            auto bumped = curve.zeroRateDeltas([&](const YieldCurve& c) { return instrument->value(c); });
+            for (size_t j = 0; j < deltas.size(); ++j)
+                REQUIRE( deltas[j] == Approx(bumped[j]).epsilon(1e-4).margin(1.0) );
+        }
+    }
+}
+
+TEST_CASE("rebuild", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto makeInstruments = [&](double x)
+    {
+        return std::vector<std::shared_ptr<Instrument>> {
+            std::make_shared<IrSwap>(1e6, 6.22 / 100 + x, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+            std::make_shared<Deposit>(1e6, 5.625 / 100 + x, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+            std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+            std::make_shared<IrSwap>(1e6, 6.01253 / 100 - x, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+        };
+    };
+
+    auto previous = YieldCurve(valueDate, makeInstruments(0.0), EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+
+    // A small move stays within the bracket around the previous rates, and a large one does not.
+    for (double x : { 0.0, 0.0002, 0.05 })
+    {
+        auto rebuilt = previous.rebuild(makeInstruments(x));
+        auto expected = YieldCurve(valueDate, makeInstruments(x), EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+
+        REQUIRE( rebuilt.points().size() == expected.points().size() );
+        for (size_t i = 0; i < expected.points().size(); ++i)
+            REQUIRE( rebuilt.points()[i].rate() == Approx(expected.points()[i].rate()).epsilon(1e-12) );
+    }
+}
+
+TEST_CASE("updateInstrumentRates", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.42 / 100, 0.0, spotDate, years{10}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::CubicSpline })
+    {
+        auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, interpolationMethod);
+
+        auto rates = std::vector<std::pair<size_t, double>>{ {3, 6.25 / 100} };
+        auto [updated, changedPoints] = curve.updateInstrumentRates(rates);
+
+        auto bumped = instruments;
+        bumped[3] = instruments[3]->clone_shared();
+        bumped[3]->rate(6.25 / 100);
+        auto expected = YieldCurve(valueDate, bumped, EDayCount::Actual_d365, interpolationMethod);
+
+        for (size_t i = 0; i < expected.points().size(); ++i)
+            REQUIRE( updated.points()[i].rate() == Approx(expected.points()[i].rate()).epsilon(1e-12) );
+
+        // The points before the change are kept.
+        REQUIRE( changedPoints == std::vector<size_t>{3, 4} );
+        for (size_t i = 0; i < 3; ++i)
+            REQUIRE( updated.points()[i].rate() == curve.points()[i].rate() );
+
+        REQUIRE( curve.instruments()[3]->rate() == 6.22 / 100 );
+    }
+}
+
+TEST_CASE("bootstrapReport", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    auto report = curve.bootstrapReport();
+
+    REQUIRE( report != nullptr );
+    REQUIRE( report->instruments.size() == instruments.size() );
+    REQUIRE( report->interpolatorConstructions + report->interpolatorAdditions == instruments.size() );
+    // The storage for every point is reserved when the interpolator is constructed.
+    REQUIRE( report->interpolatorAllocations == report->interpolatorConstructions );
+    for (size_t i = 0; i < instruments.size(); ++i)
+    {
+        const auto& solve = report->instruments[i];
+        REQUIRE( solve.maturityDate == curve.instruments()[i]->maturityDate() );
+        REQUIRE( solve.zeroRate == Approx(curve.points()[i].rate()).epsilon(1e-12) );
+        REQUIRE( solve.iterations > 0 );
+        REQUIRE( solve.iterations <= solve.evaluations );
+        REQUIRE( std::abs(solve.residual) < 1e-6 );
+    }
+    REQUIRE( report->globalIterations == 0 );
+
+    auto global = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline, EBootstrapMethod::Global);
+    REQUIRE( global.bootstrapReport()->globalIterations > 0 );
+    REQUIRE( global.bootstrapReport()->evaluations() >= global.bootstrapReport()->globalEvaluations );
+
+    // Only the instruments from the changed one onwards are solved again.
+    auto update = std::pair<size_t, double> {2, 6.1 / 100};
+    auto updated = curve.updateInstrumentRates({&update, 1});
+    REQUIRE( updated.curve.bootstrapReport()->instruments.size() == 2 );
+
+    // With recording turned off nothing is reported, and the curve is the same.
+    YieldCurve::recordBootstrapReports(false);
+    auto unreported = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::CubicSpline);
+    auto unreportedUpdate = unreported.updateInstrumentRates({&update, 1});
+    YieldCurve::recordBootstrapReports(true);
+
+    REQUIRE( YieldCurve::recordsBootstrapReports() );
+    REQUIRE( unreported.bootstrapReport() == nullptr );
+    REQUIRE( unreportedUpdate.curve.bootstrapReport() == nullptr );
+    for (size_t i = 0; i < instruments.size(); ++i)
+        REQUIRE( unreported.points()[i].rate() == curve.points()[i].rate() );
+}
+
+TEST_CASE("bootstrap.exponential", "[yield_curve]")
+{
+    auto valueDate = 2026y/January/9d;
+    auto holidays = calendars::targetHolidays(year{2026}, year{2026} + years{40});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    // Newton's method for the long deposit starts at the rate of the first and steps below zero,
+    // so the solve falls back to Brent's method, which must keep to positive rates.
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 6.0 / 100, spotDate, years{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 1.2 / 100, spotDate, years{30}, EDayCount::Actual_d360, EDateRule::Following, holidays)
+    };
+
+    auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::Exponential);
+    auto linear = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::Linear);
+
+    REQUIRE( curve.bootstrapReport()->instruments[1].usedBrent );
+    for (size_t i = 0; i < instruments.size(); ++i)
+    {
+        REQUIRE( curve.points()[i].rate() > 0.0 );
+        REQUIRE( curve.points()[i].rate() == Approx(linear.points()[i].rate()).epsilon(1e-10) );
+        REQUIRE( std::abs(curve.instruments()[i]->value(curve)) < 1e-6 );
+    }
+
+    // Rebuilding from the rates of the curve brackets them without going below zero.
+    auto rebuilt = curve.rebuild(instruments);
+    for (size_t i = 0; i < instruments.size(); ++i)
+        REQUIRE( rebuilt.points()[i].rate() == Approx(curve.points()[i].rate()).epsilon(1e-10) );
+}
+
+TEST_CASE("multiCurve", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto singleCurve = std::make_shared<YieldCurve>(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::Linear);
+
+    // Projecting off a curve discounted by itself gives the single curve.
+    auto sameCurve = YieldCurve(singleCurve, instruments, EInterpolationMethod::Linear);
+    REQUIRE( sameCurve.timeGrid() == singleCurve->timeGrid() );
+    for (size_t i = 0; i < instruments.size(); ++i)
+        REQUIRE( sameCurve.points()[i].rate() == Approx(singleCurve->points()[i].rate()).epsilon(1e-10) );
+
+    // With lower discount rates the projection curve is different, but still reprices every instrument.
+    auto discountCurve = std::make_shared<YieldCurve>(singleCurve->shift(-0.005));
+    // The sequential bootstrap only reprices every instrument with local interpolation.
+    auto methods = std::vector<std::pair<EInterpolationMethod, EBootstrapMethod>> {
+        { EInterpolationMethod::Linear, EBootstrapMethod::Sequential },
+        { EInterpolationMethod::CubicSpline, EBootstrapMethod::Global }
+    };
+    for (auto [interpolationMethod, bootstrapMethod] : methods)
+    {
+        auto forwardCurve = YieldCurve(discountCurve, instruments, interpolationMethod, bootstrapMethod);
+
+        REQUIRE( &forwardCurve.discountCurve() == discountCurve.get() );
+        REQUIRE( forwardCurve.points().back().rate() != Approx(singleCurve->points().back().rate()).epsilon(1e-6) );
+        for (const auto& instrument : forwardCurve.instruments())
+            REQUIRE( std::abs(instrument->value(*discountCurve, forwardCurve)) < 1e-6 );
+
+        // Derived curves keep the discount curve.
+        auto bumped = forwardCurve.bumpInstruments(0.0001);
+        for (const auto& instrument : bumped.instruments())
+            REQUIRE( std::abs(instrument->value(*discountCurve, bumped)) < 1e-6 );
+    }
+
+    REQUIRE_THROWS_AS( YieldCurve(std::make_shared<YieldCurve>(), instruments, EInterpolationMethod::Linear), std::invalid_argument );
+}
+
+TEST_CASE("withSpread", "[yield_curve]")
+{
+    auto valueDate = 2026y/January/9d;
+    auto holidays = calendars::targetHolidays(year{2026}, year{2026} + years{20});
+
+    auto curve = YieldCurve(
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059}, {5.0, 0.065}, {10.0, 0.07} },
+        valueDate,
+        EDayCount::Actual_d365,
+        EInterpolationMethod::CubicSpline);
+
+    // A shifted copy keeps the interpolation method, and a view gives the same rates.
+    auto shifted = curve.shift(0.01);
+    auto view = curve.withSpread(0.01);
+    REQUIRE( shifted.interpolationMethod() == EInterpolationMethod::CubicSpline );
+    REQUIRE( view.interpolationMethod() == EInterpolationMethod::CubicSpline );
+    REQUIRE( view.isSpreadView() );
+    REQUIRE( !curve.isSpreadView() );
+    REQUIRE( view.timeGrid() == curve.timeGrid() );
+    // The view shares the points of the curve rather than copying them.
+    REQUIRE( view.points().data() == curve.points().data() );
+    REQUIRE( view.withSpread(0.001).points().data() == curve.points().data() );
+
+    for (double t = 0.0; t < 12.0; t += 0.25)
+    {
+        REQUIRE( view.rate(t) == Approx(shifted.rate(t)).epsilon(1e-14) );
+        REQUIRE( view.discountFactor(t) == Approx(shifted.discountFactor(t)).epsilon(1e-14) );
+        REQUIRE( view.lastRateWeight(t) == curve.lastRateWeight(t) );
+    }
+
+    auto swap = IrSwap(1e6, 0.06, 0.0, valueDate, years{5}, EFrequency::Quarterly, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d360, days{0}, holidays);
+    REQUIRE( swap.value(view) == Approx(swap.value(shifted)).epsilon(1e-12) );
+
+    std::vector<double> ts { 0.5, 1.5, 3.0, 7.0 };
+    std::vector<double> rs(ts.size());
+    view.rates(ts, rs);
+    for (size_t i = 0; i < ts.size(); ++i)
+        REQUIRE( rs[i] == Approx(curve.rate(ts[i]) + 0.01).epsilon(1e-14) );
+
+    // A piecewise spread is linear between its times and flat outside them.
+    std::vector<double> spreadTimes { 1.0, 5.0 };
+    std::vector<double> spreads { 0.001, 0.005 };
+    auto piecewise = curve.withSpread({spreadTimes, spreads});
+    REQUIRE( piecewise.rate(0.5) == Approx(curve.rate(0.5) + 0.001).epsilon(1e-14) );
+    REQUIRE( piecewise.rate(3.0) == Approx(curve.rate(3.0) + 0.003).epsilon(1e-14) );
+    REQUIRE( piecewise.rate(8.0) == Approx(curve.rate(8.0) + 0.005).epsilon(1e-14) );
+
+    // Views can be stacked, and a view of a temporary keeps its state alive.
+    auto stacked = view.withSpread(-0.01);
+    REQUIRE( stacked.rate(3.0) == Approx(curve.rate(3.0)).epsilon(1e-14) );
+    auto temporary = curve.shift(0.01).withSpread(0.002).withSpread(-0.001);
+    REQUIRE( temporary.rate(3.0) == Approx(curve.rate(3.0) + 0.011).epsilon(1e-14) );
+
+    // Shifting works on the curve the view refers to, setting a rate does not.
+    auto shiftedView = view.shift(0.005);
+    REQUIRE( shiftedView.isSpreadView() );
+    REQUIRE( shiftedView.rate(3.0) == Approx(curve.rate(3.0) + 0.015).epsilon(1e-14) );
+    REQUIRE_THROWS_AS( view.withSpread(0.0).setLastRate(0.05), std::logic_error );
+
+    // The deltas of a view are to the points of the curve it refers to.
+    auto value = [&](const YieldCurve& c) { return swap.value(c); };
+    auto viewDeltas = view.zeroRateDeltas(value);
+    auto shiftedDeltas = shifted.zeroRateDeltas(value);
+    REQUIRE( viewDeltas.size() == curve.points().size() );
+    for (size_t i = 0; i < viewDeltas.size(); ++i)
+        REQUIRE( viewDeltas[i] == Approx(shiftedDeltas[i]).epsilon(1e-5) );
+}
+
+TEST_CASE("withSpread.bootstrapped", "[yield_curve]")
+{
+    auto valueDate = 1997y/October/6d;
+    auto holidays = calendars::targetHolidays(year{1997}, year{1997} + years{20});
+
+    auto spotDate = addBusinessDays(valueDate, days{2}, holidays);
+
+    auto instruments = std::vector<std::shared_ptr<Instrument>> {
+        std::make_shared<Deposit>(1e6, 5.625 / 100, spotDate, months{1}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<Deposit>(1e6, 5.71875 / 100, spotDate, months{3}, EDayCount::Actual_d360, EDateRule::Following, holidays),
+        std::make_shared<IrSwap>(1e6, 6.01253 / 100, 0.0, spotDate, years{2}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays),
+        std::make_shared<IrSwap>(1e6, 6.22 / 100, 0.0, spotDate, years{5}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays)
+    };
+
+    auto curve = YieldCurve(valueDate, instruments, EDayCount::Actual_d365, EInterpolationMethod::Linear);
+    auto view = curve.withSpread(0.001);
+
+    // Bumping and updating rebuild the curve the view refers to, and keep the spread.
+    auto bumped = curve.bumpInstruments(0.0001);
+    auto bumpedView = view.bumpInstruments(0.0001);
+    REQUIRE( bumpedView.isSpreadView() );
+    REQUIRE( bumpedView.rate(3.0) == Approx(bumped.rate(3.0) + 0.001).epsilon(1e-12) );
+
+    auto update = std::pair<size_t, double> {2, 6.1 / 100};
+    auto points = curve.points();
+    auto updated = curve.updateInstrumentRates({&update, 1});
+    auto updatedView = view.updateInstrumentRates({&update, 1});
+
+    // The shared points and instruments are copied before they are changed.
+    REQUIRE( curve.instruments()[2]->rate() == Approx(6.01253 / 100) );
+    for (size_t i = 0; i < points.size(); ++i)
+        REQUIRE( curve.points()[i].rate() == points[i].rate() );
+    REQUIRE( updatedView.changedPoints == updated.changedPoints );
+    REQUIRE( updatedView.curve.rate(3.0) == Approx(updated.curve.rate(3.0) + 0.001).epsilon(1e-12) );
+
+    auto ladder = view.bumpInstrumentLadder(0.0001, 2);
+    REQUIRE( ladder.size() == instruments.size() );
+    for (const auto& bumpedCurve : ladder)
+        REQUIRE( bumpedCurve.isSpreadView() );
+
+    // The instrument deltas go through the bootstrap of the curve the view refers to.
+    auto swap = IrSwap(1e6, 0.06, 0.0, valueDate, years{4}, EFrequency::SemiAnnual, EStubType::ShortFirst, EDateRule::ModFollowing, EDayCount::Actual_d365, days{2}, holidays);
+    auto value = [&](const YieldCurve& c) { return swap.value(c); };
+    auto deltas = view.instrumentDeltas(view.zeroRateDeltas(value));
+    auto expected = curve.instrumentDeltas(curve.zeroRateDeltas([&](const YieldCurve& c) { return swap.value(c.withSpread(0.001)); }));
+    for (size_t i = 0; i < deltas.size(); ++i)
+        REQUIRE( deltas[i] == Approx(expected[i]).epsilon(1e-9) );
+}
+
+TEST_CASE("rate.cursor", "[yield_curve]")
+{
+    std::vector<YieldCurvePoint> points;
+    for (int i = 1; i <= 200; ++i)
+        points.push_back({i * 0.1, 0.05 + 0.01 * std::sin(i * 0.3)});
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::CubicSpline, EInterpolationMethod::Hermite })
+    {
+        auto curve = YieldCurve(points, 2026y/January/9d, EDayCount::Actual_d365, interpolationMethod);
+
+        // Forwards, backwards and jumping about, a cursor gives the same rates.
+        maths::Interp::cursor cursor;
+        for (double t = 0.0; t < 21.0; t += 0.037)
+            REQUIRE( curve.rate(t, cursor) == curve.rate(t) );
+        for (double t = 21.0; t > 0.0; t -= 0.29)
+            REQUIRE( curve.rate(t, cursor) == curve.rate(t) );
+        for (double t : { 3.0, 17.2, 0.05, 9.95, 10.0, 20.0 })
+            REQUIRE( curve.discountFactor(t, cursor) == curve.discountFactor(t) );
+    }
+
+    // On a knot the linear rate is the point's rate, and between knots it is interpolated.
+    auto curve = YieldCurve(points, 2026y/January/9d, EDayCount::Actual_d365, EInterpolationMethod::Linear);
+    REQUIRE( curve.rate(points[57].time()) == Approx(points[57].rate()).epsilon(1e-14) );
+    double t = (points[57].time() + points[58].time()) / 2;
+    REQUIRE( curve.rate(t) == Approx((points[57].rate() + points[58].rate()) / 2).epsilon(1e-14) );
+}
+
+TEST_CASE("rates.sorted", "[yield_curve]")
+{
+    std::vector<YieldCurvePoint> points;
+    for (int i = 1; i <= 50; ++i)
+        points.push_back({i * 0.2, 0.05 + 0.01 * std::sin(i * 0.3)});
+
+    // Sorted, with repeats, the knots themselves and both ends.
+    std::vector<double> ts { 0.0, 0.1, 0.2, 0.2, 0.35 };
+    for (int i = 2; i <= 50; ++i)
+    {
+        ts.push_back(i * 0.2);
+        ts.push_back(i * 0.2 + 0.07);
+    }
+    ts.push_back(12.0);
+
+    auto reversed = std::vector<double>(ts.rbegin(), ts.rend());
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::CubicSpline, EInterpolationMethod::Hermite, EInterpolationMethod::Exponential })
+    {
+        auto curve = YieldCurve(points, 2026y/January/9d, EDayCount::Actual_d365, interpolationMethod);
+
+        // The batch and the single lookups share the same kernel, so they agree exactly.
+        std::vector<double> rs(ts.size());
+        curve.rates(ts, rs);
+        for (size_t i = 0; i < ts.size(); ++i)
+            REQUIRE( rs[i] == curve.rate(ts[i]) );
+
+        curve.rates(reversed, rs);
+        for (size_t i = 0; i < reversed.size(); ++i)
+            REQUIRE( rs[i] == curve.rate(reversed[i]) );
+    }
+}
+
+TEST_CASE("withRates", "[yield_curve]")
+{
+    std::vector<YieldCurvePoint> points;
+    for (int i = 1; i <= 20; ++i)
+        points.push_back({i * 0.5, 0.05 + 0.01 * std::sin(i * 0.3)});
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::CubicSpline, EInterpolationMethod::Hermite, EInterpolationMethod::Exponential })
+    {
+        auto curve = YieldCurve(points, 2026y/January/9d, EDayCount::Actual_d365, interpolationMethod);
+        auto spread = curve.withSpread(0.01);
+        auto view = spread.withSpread(-0.002);
+
+        // The same rates as the lookups through the interpolator, whichever way the times go.
+        for (const auto* c : { &curve, &view })
+        {
+            auto count = c->withRates([&](auto rate)
+            {
+                size_t n = 0;
+                for (double t = 0.0; t < 12.0; t += 0.1, ++n)
+                    REQUIRE( rate(t) == c->rate(t) );
+                for (double t = 12.0; t > 0.0; t -= 0.3, ++n)
+                    REQUIRE( rate(t) == c->rate(t) );
+                return n;
+            });
+            REQUIRE( count > 0 );
+        }
+    }
+
+    auto flat = YieldCurve(0.04, 2026y/January/9d, EDayCount::Actual_d365);
+    flat.withRates([](auto rate)
+    {
+        REQUIRE( rate(3.0) == 0.04 );
+        REQUIRE_THROWS_AS( rate(-1.0), std::range_error );
+    });
+
+    REQUIRE_THROWS_AS( YieldCurve{}.withRates([](auto rate) { return rate(1.0); }), std::range_error );
+}
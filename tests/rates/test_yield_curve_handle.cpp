@@ -0,0 +1,78 @@
+#include "rates/yield_curve_handle.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+static std::shared_ptr<const YieldCurve> makeCurve(double rate)
+{
+    return std::make_shared<const YieldCurve>(
+        std::vector<YieldCurvePoint>{ {1.0, rate}, {5.0, rate} },
+        2026y / January / 9d,
+        EDayCount::Actual_d365);
+}
+
+TEST_CASE("publish", "[yield_curve_handle]")
+{
+    auto handle = YieldCurveHandle{makeCurve(0.05)};
+    auto reader = handle.reader();
+
+    REQUIRE( reader->rate(2.0) == 0.05 );
+
+    auto first = handle.curve();
+    handle.publish(makeCurve(0.06));
+
+    REQUIRE( handle.version() == 2 );
+    REQUIRE( reader->rate(2.0) == 0.06 );
+    REQUIRE( reader.version() == 2 );
+
+    // A curve that is still held is not freed.
+    REQUIRE( first->rate(2.0) == 0.05 );
+    REQUIRE( first.use_count() == 1 );
+
+    // A curve kept from the reader outlives the reader moving on.
+    auto kept = reader.sharedCurve();
+    handle.publish(makeCurve(0.07));
+    REQUIRE( reader->rate(2.0) == 0.07 );
+    REQUIRE( kept->rate(2.0) == 0.06 );
+}
+
+TEST_CASE("concurrent", "[yield_curve_handle]")
+{
+    auto handle = YieldCurveHandle{makeCurve(0.0)};
+    std::atomic<bool> done {false};
+    std::atomic<int> inconsistent {0};
+
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                auto reader = handle.reader();
+                while (!done.load())
+                {
+                    // Both points of a published curve have the same rate.
+                    const auto& curve = reader.curve();
+                    if (curve.rate(1.0) != curve.rate(5.0))
+                        ++inconsistent;
+                }
+            });
+    }
+
+    for (int i = 1; i <= 200; ++i)
+        handle.publish(makeCurve(i / 10000.0));
+
+    done = true;
+    readers.clear();
+
+    REQUIRE( inconsistent == 0 );
+    REQUIRE( handle.reader()->rate(2.0) == 200 / 10000.0 );
+}
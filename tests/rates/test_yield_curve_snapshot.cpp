@@ -0,0 +1,130 @@
+#include "rates/yield_curve_snapshot.hpp"
+#include "rates/yield_curve.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+using namespace dates;
+using namespace rates;
+
+static YieldCurve makeCurve(EInterpolationMethod interpolationMethod)
+{
+    return YieldCurve{
+        { {0.1, 0.05}, {0.5, 0.06}, {1.0, 0.062}, {2.0, 0.059}, {5.0, 0.065}, {10.0, 0.07} },
+        2026y / January / 9d,
+        EDayCount::Actual_d365,
+        interpolationMethod
+    };
+}
+
+static std::string snapshotPath()
+{
+    return (std::filesystem::temp_directory_path() / "test_yield_curve_snapshot.bin").string();
+}
+
+TEST_CASE("roundTrip", "[yield_curve_snapshot]")
+{
+    auto path = snapshotPath();
+
+    for (auto interpolationMethod : { EInterpolationMethod::Linear, EInterpolationMethod::FlatForward, EInterpolationMethod::CubicSpline, EInterpolationMethod::Hermite, EInterpolationMethod::Exponential })
+    {
+        auto curve = makeCurve(interpolationMethod);
+        YieldCurveSnapshot::write(curve, path);
+
+        auto snapshot = YieldCurveSnapshot{path};
+
+        REQUIRE( snapshot.valueDate() == curve.valueDate() );
+        REQUIRE( snapshot.dayCount() == curve.dayCount() );
+        REQUIRE( snapshot.interpolationMethod() == interpolationMethod );
+        REQUIRE( snapshot.times().size() == curve.points().size() );
+        // Dates resolve through the time grid the curve shares.
+        REQUIRE( snapshot.timeGrid() == curve.timeGrid() );
+        REQUIRE( snapshot.time(2030y/March/15d) == curve.time(2030y/March/15d) );
+
+        for (double t = 0.0; t < 12.0; t += 0.05)
+        {
+            REQUIRE( snapshot.rate(t) == Approx(curve.rate(t)).epsilon(1e-12) );
+            REQUIRE( snapshot.discountFactor(t) == Approx(curve.discountFactor(t)).epsilon(1e-12) );
+        }
+
+        auto rebuilt = snapshot.curve();
+        REQUIRE( rebuilt.points() == curve.points() );
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("invalid", "[yield_curve_snapshot]")
+{
+    auto path = snapshotPath();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a snapshot, but long enough to hold a header";
+    }
+
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+}
+
+// Write a snapshot of the curve, changed by patch before it is saved.
+template <typename F>
+static void writePatched(const std::string& path, F&& patch)
+{
+    YieldCurveSnapshot::write(makeCurve(EInterpolationMethod::Linear), path);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    auto header = reinterpret_cast<YieldCurveSnapshot::Header*>(bytes.data());
+    auto data = reinterpret_cast<double*>(bytes.data() + sizeof(YieldCurveSnapshot::Header));
+    patch(*header, data);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+TEST_CASE("corrupt", "[yield_curve_snapshot]")
+{
+    auto path = snapshotPath();
+
+    // The same size as the six point curve, but with too many regions for three points.
+    writePatched(path, [](auto& header, double*) { header.pointCount = 3; header.regionCount = 8; });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto& header, double*) { header.dayCount = 99; });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto& header, double*) { header.interpolationMethod = 99; });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto& header, double*) { header.form = 99; });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto&, double* data) { std::swap(data[0], data[1]); });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto&, double* data) { data[2] = std::numeric_limits<double>::quiet_NaN(); });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    writePatched(path, [](auto& header, double*) { header.pointCount = std::uint64_t(1) << 62; });
+    REQUIRE_THROWS_AS( YieldCurveSnapshot{path}, std::runtime_error );
+
+    // Unchanged, it still loads.
+    writePatched(path, [](auto&, double*) {});
+    REQUIRE( YieldCurveSnapshot{path}.times().size() == 6 );
+
+    std::remove(path.c_str());
+}